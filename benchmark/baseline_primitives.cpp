@@ -0,0 +1,88 @@
+#include "intersection_of_two_triangles/algorithms/are_nearly_equal.hpp"
+
+#include "baseline_primitives.hpp"
+
+namespace intersection_of_two_triangles::benchmark::baseline {
+
+Vector::Vector(const double x, const double y, const double z) : x(x), y(y), z(z) {}
+
+double Vector::coord(const size_t which) const {
+    return const_cast<Vector&>(*this).coord(which);
+}
+
+double& Vector::coord(const size_t which) {
+    return (which == 0 ? x : (which == 1 ? y : z));
+}
+
+Vector& Vector::operator+=(const Vector& v) {
+    for (size_t i = 0; i < 3; ++i) {
+        coord(i) += v.coord(i);
+    }
+    return *this;
+}
+
+Vector& Vector::operator-=(const Vector& v) {
+    return *this += -v;
+}
+
+Vector& Vector::operator*=(const double value) {
+    for (size_t i = 0; i < 3; ++i) {
+        coord(i) *= value;
+    }
+    return *this;
+}
+
+Vector operator-(Vector v) {
+    return v *= -1;
+}
+
+Vector operator-(Vector v1, const Vector v2) {
+    return v1 -= v2;
+}
+
+Vector operator*(const double d, Vector v) {
+    return v *= d;
+}
+
+Point::Point(const double x, const double y, const double z) : x(x), y(y), z(z) {}
+
+Vector Point::radius_vector() const {
+    return {x, y, z};
+}
+
+double Point::coord(const size_t which) const {
+    return const_cast<Point&>(*this).coord(which);
+}
+
+double& Point::coord(const size_t which) {
+    return (which == 0 ? x : (which == 1 ? y : z));
+}
+
+Vector operator-(const Point& a, const Point& b) {
+    return a.radius_vector() - b.radius_vector();
+}
+
+Vector cross_product(const Vector& v1, const Vector& v2) {
+    const double yz = v1.y * v2.z;
+    const double zy = v1.z * v2.y;
+    const double zx = v1.z * v2.x;
+    const double xz = v1.x * v2.z;
+    const double xy = v1.x * v2.y;
+    const double yx = v1.y * v2.x;
+    if (are_nearly_equal(yz, zy) && are_nearly_equal(zx, xz) && are_nearly_equal(xy, yx)) {
+        return {0, 0, 0};
+    }
+    return {yz - zy, zx - xz, xy - yx};
+}
+
+double dot_product(const Vector& v1, const Vector& v2) {
+    const double x = v1.x * v2.x;
+    const double y = v1.y * v2.y;
+    const double z = v1.z * v2.z;
+    if (are_nearly_equal(-x, y + z) || are_nearly_equal(-y, z + x) || are_nearly_equal(-z, x + y)) {
+        return 0;
+    }
+    return x + y + z;
+}
+
+}
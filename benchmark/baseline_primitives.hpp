@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+
+namespace intersection_of_two_triangles::benchmark::baseline {
+
+// `Point` and `Vector` as they were before their coordinates were stored in arrays, kept to measure the gain: the
+// coordinates are separate members chosen by nested ternaries, the arithmetic is out of line, and `-=` adds a negated
+// temporary.
+struct Point;
+
+struct Vector {
+    Vector(double x, double y, double z);
+
+    [[nodiscard]] double coord(size_t which) const;
+    [[nodiscard]] double& coord(size_t which);
+
+    Vector& operator+=(const Vector&);
+    Vector& operator-=(const Vector&);
+    Vector& operator*=(double);
+
+    double x, y, z;
+};
+
+[[nodiscard]] Vector operator-(Vector);
+[[nodiscard]] Vector operator-(Vector, Vector);
+[[nodiscard]] Vector operator*(double, Vector);
+
+struct Point {
+    Point() = default;
+    Point(double x, double y, double z);
+
+    [[nodiscard]] Vector radius_vector() const;
+    [[nodiscard]] double coord(size_t which) const;
+    [[nodiscard]] double& coord(size_t which);
+
+    double x{}, y{}, z{};
+};
+
+[[nodiscard]] Vector operator-(const Point&, const Point&);
+
+// With the default tolerance, like the library functions.
+[[nodiscard]] Vector cross_product(const Vector&, const Vector&);
+[[nodiscard]] double dot_product(const Vector&, const Vector&);
+
+}
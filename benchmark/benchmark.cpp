@@ -0,0 +1,764 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <random>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "intersection_of_two_triangles/algorithms/are_intersecting.hpp"
+#include "intersection_of_two_triangles/algorithms/batch_intersection.hpp"
+#include "intersection_of_two_triangles/algorithms/cascade_intersection.hpp"
+#include "intersection_of_two_triangles/algorithms/cross_product.hpp"
+#include "intersection_of_two_triangles/algorithms/dot_product.hpp"
+#include "intersection_of_two_triangles/algorithms/exact_predicates.hpp"
+#include "intersection_of_two_triangles/algorithms/mesh_index.hpp"
+#include "intersection_of_two_triangles/algorithms/scene.hpp"
+#include "intersection_of_two_triangles/algorithms/uniform_grid.hpp"
+#include "intersection_of_two_triangles/algorithms/voxelizer.hpp"
+#include "intersection_of_two_triangles/exception.hpp"
+#include "intersection_of_two_triangles/primitives/line.hpp"
+#include "intersection_of_two_triangles/primitives/plane.hpp"
+#include "intersection_of_two_triangles/primitives/point.hpp"
+#include "intersection_of_two_triangles/primitives/quantized_triangle.hpp"
+#include "intersection_of_two_triangles/primitives/segment.hpp"
+#include "intersection_of_two_triangles/primitives/triangle.hpp"
+#include "intersection_of_two_triangles/primitives/vector.hpp"
+#include "intersection_of_two_triangles/profiling/code_path.hpp"
+#include "intersection_of_two_triangles/profiling/performance_counters.hpp"
+#include "intersection_of_two_triangles/utility/concurrent_disjoint_sets.hpp"
+
+#include "baseline_primitives.hpp"
+#include "workloads.hpp"
+
+namespace {
+
+using namespace intersection_of_two_triangles;
+using namespace intersection_of_two_triangles::benchmark;
+
+constexpr std::string_view usage =
+    "Usage: intersection_of_two_triangles_benchmark <benchmark> [options] [test_file...]\n"
+    "Benchmarks:\n"
+    "  grid       find the intersecting pairs and their connected components in a generated triangle soup with the\n"
+    "             uniform grid and compare it with the all-pairs loop\n"
+    "  voxelize   voxelize a generated triangle soup into dense and sparse grids, and compare the triangle-box\n"
+    "             test with checking the cells split into triangles\n"
+    "  pairs      the throughput of are_intersecting and of are_intersecting_batch on the test files and on\n"
+    "             generated pairs\n"
+    "  primitives the time per pair of the steps built on the arithmetic of points and vectors: the planes of\n"
+    "             the triangles and the line where they meet, the tests of the edges against each other and the\n"
+    "             whole triangle-triangle test, and the same arithmetic with the array-backed primitives compared\n"
+    "             with the baseline ones\n"
+    "  cascade    the throughput of are_intersecting_cascade, the share of pairs its single-precision filter\n"
+    "             certifies and the speedup over the double-precision paths on the test files and generated pairs\n"
+    "  scene      place copies of generated meshes by rigid transforms and compare the two-level scene index with\n"
+    "             one index over the triangles transformed into world space: the build, segment queries, contacts\n"
+    "             between the copies and moving some of them\n"
+    "  quantized  compare the exact predicates on quantized inputs with the floating-point path on the test files\n"
+    "             and on generated grid-snapped data\n"
+    "Options:\n"
+    "  --resolution <value>  the step of the lattice of the quantized benchmark\n"
+    "  --perf-counters       count cycles, instructions, branch and cache misses per pair and per code path\n"
+    "  --size <value>        the number of triangles of the generated meshes\n"
+    "  --threads <value>     the number of threads of the parallel algorithms\n";
+
+struct Options {
+    double resolution = 1.0 / (1 << 20);
+    bool perf_counters = false;
+    size_t size = 1'000'000;
+    size_t threads = default_number_of_threads();
+};
+
+// The all-pairs loop over a million triangles would take days, so it is run for this many triangles against all
+// the others, and its time is extrapolated.
+constexpr size_t all_pairs_sample_size = 16;
+
+constexpr size_t generated_workload_size = 200'000;
+
+[[nodiscard]] double seconds_since(const std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Runs `pass` until at least a second is spent and returns the average duration of a pass in seconds.
+template<class Pass>
+[[nodiscard]] double measure(Pass&& pass) {
+    using Clock = std::chrono::steady_clock;
+    const auto start = Clock::now();
+    size_t passes = 0;
+    do {
+        pass();
+        ++passes;
+    } while (Clock::now() - start < std::chrono::seconds(1));
+    return std::chrono::duration<double>(Clock::now() - start).count() / passes;
+}
+
+void print_throughput(const std::string_view name, const size_t pairs, const double seconds) {
+    std::cout << "  " << std::left << std::setw(14) << name << std::right << std::setw(12) << std::fixed
+              << std::setprecision(0) << pairs / seconds << " pairs/s" << std::defaultfloat
+              << std::setprecision(6) << '\n';
+}
+
+void print_time_per_pair(const std::string_view name, const size_t pairs, const double seconds) {
+    std::cout << "  " << std::left << std::setw(14) << name << std::right << std::setw(12) << std::fixed
+              << std::setprecision(1) << seconds / pairs * 1e9 << " ns/pair" << std::defaultfloat
+              << std::setprecision(6) << '\n';
+}
+
+// Reads the performance counters around every pair, which is done in a separate pass, since reading them takes
+// a system call.
+void report_performance_counters(const Workload& workload) {
+    const PerformanceCounters counters;
+    PerformanceCountersReport report;
+    for (const TestCase& test: workload.tests) {
+        const CounterValues before = counters.read();
+        [[maybe_unused]] const bool result = are_intersecting(test.triangles[0], test.triangles[1]);
+        const CounterValues after = counters.read();
+        report.add(code_path(test.triangles[0], test.triangles[1]), before, after);
+    }
+    report.print(std::cout, counters);
+}
+
+void run_grid(const Options& options) {
+    const std::vector<GeneralTriangle> triangles = generate_triangle_soup(options.size, 4);
+    std::cout << "soup of " << triangles.size() << " triangles, " << options.threads << " threads\n";
+
+    auto start = std::chrono::steady_clock::now();
+    const UniformGrid grid(triangles, default_tolerance, options.threads);
+    const double build_time = seconds_since(start);
+    std::cout << "  grid build       " << build_time << " s, cell size " << grid.cell_size() << ", "
+              << grid.number_of_entries() << " entries\n";
+
+    start = std::chrono::steady_clock::now();
+    const auto pairs = find_intersecting_pairs(triangles, default_tolerance, options.threads);
+    const double grid_time = seconds_since(start);
+    std::cout << "  grid search      " << grid_time << " s, " << pairs.size() << " intersecting pairs\n";
+
+    start = std::chrono::steady_clock::now();
+    const std::vector<size_t> components = find_intersecting_components(triangles, default_tolerance, options.threads);
+    const double components_time = seconds_since(start);
+    ConcurrentDisjointSets expected_components(triangles.size());
+    for (const auto& [a, b]: pairs) {
+        expected_components.unite(a, b);
+    }
+    size_t number_of_components = 0;
+    size_t mismatches = 0;
+    for (size_t i = 0; i < triangles.size(); ++i) {
+        number_of_components += components[i] == i;
+        mismatches += components[i] != expected_components.find(i);
+    }
+    std::cout << "  grid components  " << components_time << " s, " << number_of_components << " components, "
+              << mismatches << " labels differ from the components of the pairs\n";
+
+    const size_t sample_size = std::min(all_pairs_sample_size, triangles.size());
+    size_t sample_pairs = 0;
+    start = std::chrono::steady_clock::now();
+    for (size_t a = 0; a < sample_size; ++a) {
+        for (size_t b = 0; b < triangles.size(); ++b) {
+            sample_pairs += a != b && are_intersecting(triangles[a], triangles[b]);
+        }
+    }
+    const double sample_time = seconds_since(start);
+    const double all_pairs_time = sample_time / std::max<size_t>(1, sample_size) * triangles.size() / 2;
+    std::cout << "  all-pairs loop   " << all_pairs_time << " s (extrapolated from " << sample_size
+              << " triangles), " << all_pairs_time / grid_time << "x slower\n";
+
+    size_t grid_sample_pairs = 0;
+    for (const auto& [a, b]: pairs) {
+        grid_sample_pairs += (a < sample_size) + (b < sample_size);
+    }
+    std::cout << "  the sampled triangles are in " << sample_pairs << " intersecting pairs by the all-pairs loop and in "
+              << grid_sample_pairs << " by the grid\n";
+}
+
+// Checks the triangle against the 12 triangles of the faces of the box, plus the containment of a vertex, which is
+// what the triangle-box test replaces.
+[[nodiscard]] bool are_intersecting_split_box(const GeneralTriangle& gt, const Box& box) {
+    std::array<Point, 8> corners;
+    for (size_t i = 0; i < 8; ++i) {
+        corners[i] = Point(i & 1 ? box.max.x() : box.min.x(), i & 2 ? box.max.y() : box.min.y(),
+                           i & 4 ? box.max.z() : box.min.z());
+    }
+    constexpr size_t faces[6][4] = {{0, 1, 3, 2}, {4, 5, 7, 6}, {0, 1, 5, 4}, {2, 3, 7, 6}, {0, 2, 6, 4}, {1, 3, 7, 5}};
+    for (const auto& face: faces) {
+        if (are_intersecting(gt, GeneralTriangle{corners[face[0]], corners[face[1]], corners[face[2]]}) ||
+            are_intersecting(gt, GeneralTriangle{corners[face[0]], corners[face[2]], corners[face[3]]})) {
+            return true;
+        }
+    }
+    return box.contains(gt.vertices[0]);
+}
+
+void run_voxelize(const Options& options) {
+    const std::vector<GeneralTriangle> triangles = generate_triangle_soup(options.size, 5);
+    const VoxelGrid grid = VoxelGrid::around(triangles, 1);
+    std::cout << "soup of " << triangles.size() << " triangles, grid of " << grid.dimensions[0] << 'x'
+              << grid.dimensions[1] << 'x' << grid.dimensions[2] << " cells, " << options.threads << " threads\n";
+
+    auto start = std::chrono::steady_clock::now();
+    const std::vector<std::uint8_t> dense = voxelize_dense(triangles, grid, default_tolerance, options.threads);
+    const double dense_time = seconds_since(start);
+    start = std::chrono::steady_clock::now();
+    const std::vector<size_t> sparse = voxelize_sparse(triangles, grid, default_tolerance, options.threads);
+    const double sparse_time = seconds_since(start);
+    std::cout << "  dense            " << dense_time << " s\n";
+    std::cout << "  sparse           " << sparse_time << " s, " << sparse.size() << " occupied cells\n";
+
+    // The cells around the first triangles, tested both ways.
+    std::vector<std::pair<size_t, Box>> cases;
+    for (size_t t = 0; t < std::min<size_t>(triangles.size(), 1000); ++t) {
+        const Box bounds = bounding_box(triangles[t]);
+        const VoxelGrid::Cell first{static_cast<size_t>((bounds.min.x() - grid.origin.x()) / grid.cell_size),
+                                    static_cast<size_t>((bounds.min.y() - grid.origin.y()) / grid.cell_size),
+                                    static_cast<size_t>((bounds.min.z() - grid.origin.z()) / grid.cell_size)};
+        for (size_t i = 0; i < 27; ++i) {
+            const VoxelGrid::Cell cell{first[0] + i % 3, first[1] + i / 3 % 3, first[2] + i / 9};
+            cases.emplace_back(t, grid.cell_box(cell));
+        }
+    }
+    std::vector<char> box_results(cases.size());
+    std::vector<char> split_results(cases.size());
+    const double box_time = measure([&]() {
+        for (size_t i = 0; i < cases.size(); ++i) {
+            box_results[i] = are_intersecting(triangles[cases[i].first], cases[i].second);
+        }
+    });
+    const double split_time = measure([&]() {
+        for (size_t i = 0; i < cases.size(); ++i) {
+            split_results[i] = are_intersecting_split_box(triangles[cases[i].first], cases[i].second);
+        }
+    });
+    size_t disagreements = 0;
+    for (size_t i = 0; i < cases.size(); ++i) {
+        disagreements += box_results[i] != split_results[i];
+    }
+    std::cout << cases.size() << " triangle-cell tests:\n";
+    print_throughput("triangle-box", cases.size(), box_time);
+    print_throughput("split box", cases.size(), split_time);
+    std::cout << "  the tests disagree on " << disagreements << " cells\n";
+}
+
+void run_pairs(const std::vector<Workload>& workloads, const Options& options) {
+    for (const Workload& workload: workloads) {
+        std::vector<char> results(workload.tests.size());
+        const double time = measure([&]() {
+            for (size_t i = 0; i < workload.tests.size(); ++i) {
+                results[i] = are_intersecting(workload.tests[i].triangles[0], workload.tests[i].triangles[1]);
+            }
+        });
+
+        std::vector<TrianglePair> pairs;
+        pairs.reserve(workload.tests.size());
+        for (const TestCase& test: workload.tests) {
+            pairs.push_back(test.triangles);
+        }
+        std::vector<bool> batch_results;
+        const double batch_time = measure([&]() {
+            batch_results = are_intersecting_batch(pairs);
+        });
+        size_t disagreements = 0;
+        for (size_t i = 0; i < results.size(); ++i) {
+            disagreements += static_cast<bool>(results[i]) != batch_results[i];
+        }
+
+        std::cout << workload.name << ": " << workload.tests.size() << " pairs\n";
+        print_throughput("double", workload.tests.size(), time);
+        print_throughput("batched", workload.tests.size(), batch_time);
+        if (disagreements != 0) {
+            std::cout << "  the batched results disagree on " << disagreements << " pairs\n";
+        }
+        if (options.perf_counters) {
+            report_performance_counters(workload);
+        }
+    }
+}
+
+[[nodiscard]] double coordinate(const Vector& v, const size_t which) {
+    return v[which];
+}
+
+[[nodiscard]] double coordinate(const baseline::Vector& v, const size_t which) {
+    return v.coord(which);
+}
+
+// The arithmetic of the planes of the triangles and of the point where their line crosses a coordinate plane, written
+// once for the current and the baseline primitives.
+template<class P>
+[[nodiscard]] double line_of_planes(const std::array<P, 3>& t1, const std::array<P, 3>& t2) {
+    const auto n1 = cross_product(t1[1] - t1[0], t1[2] - t1[0]);
+    const auto n2 = cross_product(t2[1] - t2[0], t2[2] - t2[0]);
+    const double d1 = -dot_product(n1, t1[0].radius_vector());
+    const double d2 = -dot_product(n2, t2[0].radius_vector());
+    const auto direction = cross_product(n1, n2);
+    size_t axis = 0;
+    for (size_t i = 1; i < 3; ++i) {
+        if (std::abs(coordinate(direction, i)) > std::abs(coordinate(direction, axis))) {
+            axis = i;
+        }
+    }
+    const size_t i1 = (axis + 1) % 3;
+    const size_t i2 = (axis + 2) % 3;
+    const double determinant = coordinate(direction, axis);
+    if (determinant == 0) {
+        return 0;
+    }
+    return (d2 * coordinate(n1, i2) - d1 * coordinate(n2, i2)) / determinant +
+           (d1 * coordinate(n2, i1) - d2 * coordinate(n1, i1)) / determinant;
+}
+
+// The arithmetic of the segment-segment test: solves `a + t * (b - a) = c + s * (d - c)` in the coordinate plane
+// with the largest determinant and checks the gap in the remaining coordinate.
+template<class P>
+[[nodiscard]] bool do_edges_meet(const P& a, const P& b, const P& c, const P& d) {
+    const auto u = b - a;
+    const auto v = d - c;
+    const auto w = c - a;
+    size_t best = 0;
+    double best_determinant = 0;
+    for (size_t k = 0; k < 3; ++k) {
+        const size_t i = (k + 1) % 3;
+        const size_t j = (k + 2) % 3;
+        const double determinant = coordinate(v, i) * coordinate(u, j) - coordinate(u, i) * coordinate(v, j);
+        if (std::abs(determinant) > std::abs(best_determinant)) {
+            best = k;
+            best_determinant = determinant;
+        }
+    }
+    if (best_determinant == 0) {
+        return false;
+    }
+    const size_t i = (best + 1) % 3;
+    const size_t j = (best + 2) % 3;
+    const double t = (coordinate(v, i) * coordinate(w, j) - coordinate(w, i) * coordinate(v, j)) / best_determinant;
+    const double s = (coordinate(u, i) * coordinate(w, j) - coordinate(u, j) * coordinate(w, i)) / best_determinant;
+    const auto gap = t * u - s * v - w;
+    return 0 <= t && t <= 1 && 0 <= s && s <= 1 && std::abs(coordinate(gap, best)) < 1e-9;
+}
+
+// Runs the arithmetic of the planes and of the edges on the pairs and returns their durations per pass and the counts
+// of the results, which keep the passes from being optimized away.
+template<class P>
+[[nodiscard]] std::array<double, 4> measure_arithmetic(const std::vector<std::array<std::array<P, 3>, 2>>& pairs) {
+    double sum = 0;
+    const double planes_time = measure([&]() {
+        sum = 0;
+        for (const auto& [t1, t2]: pairs) {
+            sum += line_of_planes(t1, t2);
+        }
+    });
+    size_t meeting_edges = 0;
+    const double edges_time = measure([&]() {
+        meeting_edges = 0;
+        for (const auto& [t1, t2]: pairs) {
+            for (size_t i = 0; i < 3; ++i) {
+                for (size_t j = 0; j < 3; ++j) {
+                    meeting_edges += do_edges_meet(t1[i], t1[(i + 1) % 3], t2[j], t2[(j + 1) % 3]);
+                }
+            }
+        }
+    });
+    return {planes_time, edges_time, sum, static_cast<double>(meeting_edges)};
+}
+
+void print_comparison(const std::string_view name, const size_t pairs, const double baseline_seconds,
+                      const double seconds) {
+    std::cout << "  " << std::left << std::setw(14) << name << std::right << std::setw(12) << std::fixed
+              << std::setprecision(1) << baseline_seconds / pairs * 1e9 << " ->" << std::setw(8)
+              << seconds / pairs * 1e9 << " ns/pair, " << std::setprecision(2) << baseline_seconds / seconds
+              << "x" << std::defaultfloat << std::setprecision(6) << '\n';
+}
+
+void run_primitives(const std::vector<Workload>& workloads) {
+    for (const Workload& workload: workloads) {
+        // The pairs of non-degenerate triangles, which take the paths through the planes and the edges.
+        std::vector<std::array<Triangle, 2>> pairs;
+        for (const TestCase& test: workload.tests) {
+            const auto decomposed1 = test.triangles[0].as_non_degenerate();
+            const auto decomposed2 = test.triangles[1].as_non_degenerate();
+            if (decomposed1.size() == 1 && decomposed2.size() == 1 &&
+                std::holds_alternative<Triangle>(decomposed1[0]) && std::holds_alternative<Triangle>(decomposed2[0])) {
+                pairs.push_back({std::get<Triangle>(decomposed1[0]), std::get<Triangle>(decomposed2[0])});
+            }
+        }
+        if (pairs.empty()) {
+            continue;
+        }
+
+        // The same arithmetic on the baseline primitives and on the current ones.
+        std::vector<std::array<std::array<baseline::Point, 3>, 2>> baseline_pairs;
+        std::vector<std::array<std::array<Point, 3>, 2>> current_pairs;
+        for (const auto& pair: pairs) {
+            std::array<std::array<baseline::Point, 3>, 2> baseline_pair;
+            std::array<std::array<Point, 3>, 2> current_pair;
+            for (size_t t = 0; t < 2; ++t) {
+                for (size_t v = 0; v < 3; ++v) {
+                    const Point& p = pair[t].vertex(v);
+                    baseline_pair[t][v] = baseline::Point(p.x(), p.y(), p.z());
+                    current_pair[t][v] = p;
+                }
+            }
+            baseline_pairs.push_back(baseline_pair);
+            current_pairs.push_back(current_pair);
+        }
+        const auto baseline_arithmetic = measure_arithmetic(baseline_pairs);
+        const auto current_arithmetic = measure_arithmetic(current_pairs);
+
+        size_t meeting_planes = 0;
+        const double planes_time = measure([&]() {
+            meeting_planes = 0;
+            for (const auto& [t1, t2]: pairs) {
+                const Plane p1(t1.vertex(0), t1.vertex(1), t1.vertex(2));
+                const Plane p2(t2.vertex(0), t2.vertex(1), t2.vertex(2));
+                meeting_planes += intersection(p1, p2).has_value();
+            }
+        });
+        size_t intersecting_edges = 0;
+        const double edges_time = measure([&]() {
+            intersecting_edges = 0;
+            for (const auto& [t1, t2]: pairs) {
+                for (size_t i = 0; i < 3; ++i) {
+                    for (size_t j = 0; j < 3; ++j) {
+                        intersecting_edges += are_intersecting(t1.edge(i), t2.edge(j));
+                    }
+                }
+            }
+        });
+        size_t intersecting_pairs = 0;
+        const double pairs_time = measure([&]() {
+            intersecting_pairs = 0;
+            for (const auto& [t1, t2]: pairs) {
+                intersecting_pairs += are_intersecting(t1, t2);
+            }
+        });
+
+        std::cout << workload.name << ": " << pairs.size() << " pairs of non-degenerate triangles\n";
+        std::cout << "  the arithmetic with the baseline -> the current primitives:\n";
+        print_comparison("planes", pairs.size(), baseline_arithmetic[0], current_arithmetic[0]);
+        print_comparison("9 edge pairs", pairs.size(), baseline_arithmetic[1], current_arithmetic[1]);
+        if (baseline_arithmetic[2] != current_arithmetic[2] || baseline_arithmetic[3] != current_arithmetic[3]) {
+            std::cout << "  the baseline and the current primitives computed different results\n";
+        }
+        std::cout << "  the library algorithms:\n";
+        print_time_per_pair("planes", pairs.size(), planes_time);
+        print_time_per_pair("9 edge pairs", pairs.size(), edges_time);
+        print_time_per_pair("triangles", pairs.size(), pairs_time);
+        std::cout << "  " << meeting_planes << " pairs of planes meet in a line, " << intersecting_edges
+                  << " pairs of edges and " << intersecting_pairs << " pairs of triangles intersect\n";
+    }
+}
+
+void run_cascade(const std::vector<Workload>& workloads) {
+    for (const Workload& workload: workloads) {
+        std::vector<TrianglePair> pairs;
+        pairs.reserve(workload.tests.size());
+        for (const TestCase& test: workload.tests) {
+            pairs.push_back(test.triangles);
+        }
+        std::vector<char> results(pairs.size());
+        const double time = measure([&]() {
+            for (size_t i = 0; i < pairs.size(); ++i) {
+                results[i] = are_intersecting(pairs[i][0], pairs[i][1]);
+            }
+        });
+        const double batch_time = measure([&]() {
+            static_cast<void>(are_intersecting_batch(pairs));
+        });
+        std::vector<bool> cascade_results;
+        CascadeStatistics statistics;
+        const double cascade_time = measure([&]() {
+            cascade_results = are_intersecting_cascade(pairs, default_tolerance, &statistics);
+        });
+
+        // The certified answers are exact, so they may differ from the double-precision answers where the epsilons
+        // misjudge a pair, which is counted separately when the right answers are known.
+        size_t disagreements = 0;
+        size_t double_failures = 0;
+        size_t cascade_failures = 0;
+        for (size_t i = 0; i < pairs.size(); ++i) {
+            disagreements += static_cast<bool>(results[i]) != cascade_results[i];
+            if (workload.has_expected_answers) {
+                double_failures += static_cast<bool>(results[i]) != workload.tests[i].expected_answer;
+                cascade_failures += cascade_results[i] != workload.tests[i].expected_answer;
+            }
+        }
+
+        std::cout << workload.name << ": " << pairs.size() << " pairs\n";
+        print_throughput("double", pairs.size(), time);
+        print_throughput("batched", pairs.size(), batch_time);
+        print_throughput("cascade", pairs.size(), cascade_time);
+        const size_t certified = statistics.certified_disjoint + statistics.certified_intersecting;
+        std::cout << std::fixed << std::setprecision(1) << "  certified " << 100.0 * certified / pairs.size()
+                  << "% (" << statistics.certified_disjoint << " disjoint, " << statistics.certified_intersecting
+                  << " intersecting), rechecked " << statistics.rechecked << '\n'
+                  << std::setprecision(2) << "  speedup " << time / cascade_time << "x over double, "
+                  << batch_time / cascade_time << "x over batched\n" << std::defaultfloat
+                  << "  the cascade disagrees with double on " << disagreements << " pairs\n";
+        if (workload.has_expected_answers) {
+            std::cout << "  wrong answers: " << double_failures << " double, " << cascade_failures << " cascade\n";
+        }
+    }
+}
+
+void run_quantized(const std::vector<Workload>& workloads, const Quantizer& quantizer) {
+    for (const Workload& workload: workloads) {
+        std::vector<std::array<QuantizedTriangle, 2>> quantized;
+        std::vector<const TestCase*> tests;
+        for (const TestCase& test: workload.tests) {
+            try {
+                quantized.push_back({quantizer.quantize(test.triangles[0]), quantizer.quantize(test.triangles[1])});
+                tests.push_back(&test);
+            } catch (const Exception&) {
+            }
+        }
+
+        std::vector<char> double_results(tests.size());
+        std::vector<char> exact_results(tests.size());
+        const double double_time = measure([&]() {
+            for (size_t i = 0; i < tests.size(); ++i) {
+                double_results[i] = are_intersecting(tests[i]->triangles[0], tests[i]->triangles[1]);
+            }
+        });
+        const double exact_time = measure([&]() {
+            for (size_t i = 0; i < tests.size(); ++i) {
+                exact_results[i] = are_intersecting(quantized[i][0], quantized[i][1]);
+            }
+        });
+
+        size_t disagreements = 0;
+        size_t double_failures = 0;
+        size_t exact_failures = 0;
+        size_t off_lattice = 0;
+        for (size_t i = 0; i < tests.size(); ++i) {
+            disagreements += double_results[i] != exact_results[i];
+            double_failures += double_results[i] != tests[i]->expected_answer;
+            exact_failures += exact_results[i] != tests[i]->expected_answer;
+            for (const GeneralTriangle& gt: tests[i]->triangles) {
+                for (const Point& vertex: gt.vertices) {
+                    if (!quantizer.is_on_lattice(vertex)) {
+                        ++off_lattice;
+                        break;
+                    }
+                }
+            }
+        }
+
+        std::cout << workload.name << ": " << tests.size() << " of " << workload.tests.size()
+                  << " pairs fit the lattice, " << off_lattice << " triangles were moved by the quantization\n";
+        print_throughput("double", tests.size(), double_time);
+        print_throughput("exact integer", tests.size(), exact_time);
+        std::cout << "  the paths disagree on " << disagreements << " pairs\n";
+        if (workload.has_expected_answers) {
+            std::cout << "  wrong answers: " << double_failures << " double, " << exact_failures
+                      << " exact integer\n";
+        }
+    }
+}
+
+// The rotation about a random axis by a random angle, then the translation by a random vector within `extent`.
+[[nodiscard]] RigidTransform random_transform(std::mt19937_64& generator, const double extent) {
+    constexpr double pi = 3.14159265358979323846;
+    std::normal_distribution<double> direction(0, 1);
+    std::uniform_real_distribution<double> angle(0, 2 * pi);
+    std::uniform_real_distribution<double> offset(0, extent);
+    const Vector axis(direction(generator), direction(generator), direction(generator));
+    return RigidTransform::rotation(axis, angle(generator),
+                                    Vector(offset(generator), offset(generator), offset(generator)));
+}
+
+void run_scene(const Options& options) {
+    constexpr size_t number_of_meshes = 4;
+    constexpr size_t number_of_instances = 64;
+    constexpr size_t number_of_moves = 8;
+    const size_t mesh_size = std::max<size_t>(1, options.size / 100);
+    std::vector<std::vector<GeneralTriangle>> meshes;
+    for (size_t m = 0; m < number_of_meshes; ++m) {
+        meshes.push_back(generate_triangle_soup(mesh_size, 10 + m));
+    }
+    // The soups are cubes of this side, and the copies are scattered over a cube of twice their side, so that each
+    // overlaps several others.
+    const double side = 2 * std::cbrt(static_cast<double>(mesh_size));
+    std::mt19937_64 generator(6);
+    std::vector<RigidTransform> transforms;
+    for (size_t i = 0; i < number_of_instances; ++i) {
+        transforms.push_back(random_transform(generator, 2 * side));
+    }
+    std::cout << number_of_instances << " copies of " << number_of_meshes << " soups of " << mesh_size
+              << " triangles\n";
+
+    // The baked index numbers the triangles of instance `i` from `i * mesh_size`.
+    const auto bake = [&]() {
+        std::vector<GeneralTriangle> world;
+        world.reserve(number_of_instances * mesh_size);
+        for (size_t i = 0; i < number_of_instances; ++i) {
+            for (const GeneralTriangle& gt: meshes[i % number_of_meshes]) {
+                world.push_back(transforms[i](gt));
+            }
+        }
+        return MeshIndex(std::move(world));
+    };
+    auto start = std::chrono::steady_clock::now();
+    std::optional<MeshIndex> baked(bake());
+    const double baked_build_time = seconds_since(start);
+
+    start = std::chrono::steady_clock::now();
+    Scene scene;
+    for (const auto& mesh: meshes) {
+        scene.add_mesh(std::make_shared<const MeshIndex>(mesh));
+    }
+    for (size_t i = 0; i < number_of_instances; ++i) {
+        scene.add_instance(i % number_of_meshes, transforms[i]);
+    }
+    const double scene_build_time = seconds_since(start);
+    std::cout << "  baked build      " << baked_build_time << " s\n";
+    std::cout << "  scene build      " << scene_build_time << " s\n";
+
+    std::uniform_real_distribution<double> coordinate(-side, 3 * side);
+    std::normal_distribution<double> direction(0, 1);
+    std::vector<Segment> segments;
+    for (size_t i = 0; i < generated_workload_size; ++i) {
+        const Point a(coordinate(generator), coordinate(generator), coordinate(generator));
+        Vector d(direction(generator), direction(generator), direction(generator));
+        d *= side / 4 / d.length();
+        segments.emplace_back(a, a + d);
+    }
+    // The number of hits found by only one of the indexes.
+    const auto count_differences = [&]() {
+        std::vector<std::pair<size_t, size_t>> expected;
+        for (const MeshHit& hit: baked->intersect(segments)) {
+            expected.emplace_back(hit.query, hit.triangle);
+        }
+        std::vector<std::pair<size_t, size_t>> hits;
+        for (const SceneHit& hit: scene.intersect(segments)) {
+            hits.emplace_back(hit.query, hit.instance * mesh_size + hit.triangle);
+        }
+        std::vector<std::pair<size_t, size_t>> differences;
+        std::set_symmetric_difference(expected.begin(), expected.end(), hits.begin(), hits.end(),
+                                      std::back_inserter(differences));
+        return std::pair(hits.size(), differences.size());
+    };
+    const double baked_query_time = measure([&]() { (void)baked->intersect(segments); });
+    const double scene_query_time = measure([&]() { (void)scene.intersect(segments); });
+    const auto [hits, differences] = count_differences();
+    std::cout << segments.size() << " segments, " << hits << " hits, " << differences
+              << " differ between the indexes:\n";
+    print_throughput("baked", segments.size(), baked_query_time);
+    print_throughput("scene", segments.size(), scene_query_time);
+
+    start = std::chrono::steady_clock::now();
+    const std::vector<std::pair<size_t, size_t>> baked_pairs = baked->intersect(*baked);
+    const double baked_contacts_time = seconds_since(start);
+    size_t expected_contact_pairs = 0;
+    for (const auto& [a, b]: baked_pairs) {
+        expected_contact_pairs += a / mesh_size < b / mesh_size;
+    }
+    start = std::chrono::steady_clock::now();
+    size_t contact_pairs = 0;
+    const std::vector<InstanceContact> contacts = scene.find_intersecting_instances();
+    for (const InstanceContact& contact: contacts) {
+        contact_pairs += contact.triangles.size();
+    }
+    const double scene_contacts_time = seconds_since(start);
+    std::cout << "contacts between the copies:\n";
+    std::cout << "  baked            " << baked_contacts_time << " s, " << expected_contact_pairs
+              << " intersecting pairs\n";
+    std::cout << "  scene            " << scene_contacts_time << " s, " << contact_pairs << " intersecting pairs in "
+              << contacts.size() << " pairs of copies\n";
+
+    // The baked index has to be rebuilt after a move, the scene only refits its top level.
+    for (size_t i = 0; i < number_of_moves; ++i) {
+        transforms[i * number_of_instances / number_of_moves] = random_transform(generator, 2 * side);
+    }
+    start = std::chrono::steady_clock::now();
+    baked.reset();
+    baked.emplace(bake());
+    const double baked_move_time = seconds_since(start);
+    start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < number_of_moves; ++i) {
+        const size_t instance = i * number_of_instances / number_of_moves;
+        scene.set_transform(instance, transforms[instance]);
+    }
+    const double scene_move_time = seconds_since(start);
+    const auto [moved_hits, moved_differences] = count_differences();
+    std::cout << "moving " << number_of_moves << " copies:\n";
+    std::cout << "  baked rebuild    " << baked_move_time << " s\n";
+    std::cout << "  scene refit      " << scene_move_time << " s, " << baked_move_time / scene_move_time
+              << "x faster\n";
+    std::cout << "  then " << moved_hits << " hits, " << moved_differences << " differ between the indexes\n";
+}
+
+}
+
+int main(const int argc, const char* const* const argv) {
+    if (argc < 2) {
+        std::cerr << usage;
+        return 1;
+    }
+    const std::string_view benchmark = argv[1];
+
+    Options options;
+    int i = 2;
+    for (; i < argc && std::string_view(argv[i]).substr(0, 2) == "--"; ++i) {
+        const std::string_view option = argv[i];
+        if (option == "--resolution" && i + 1 < argc) {
+            options.resolution = std::strtod(argv[++i], nullptr);
+            continue;
+        }
+        if ((option == "--size" || option == "--threads") && i + 1 < argc) {
+            (option == "--size" ? options.size : options.threads) = std::strtoull(argv[++i], nullptr, 10);
+            continue;
+        }
+        if (option == "--perf-counters") {
+            options.perf_counters = true;
+            continue;
+        }
+        std::cerr << "Unknown option " << option << '\n' << usage;
+        return 1;
+    }
+
+    try {
+        std::vector<Workload> workloads;
+        for (; i < argc; ++i) {
+            workloads.push_back(read_test_file(argv[i]));
+        }
+
+        if (benchmark == "grid") {
+            run_grid(options);
+        } else if (benchmark == "voxelize") {
+            run_voxelize(options);
+        } else if (benchmark == "pairs") {
+            workloads.push_back(generate_random_pairs(generated_workload_size, 3));
+            workloads.push_back(generate_grid_pairs(generated_workload_size, 16, 1));
+            run_pairs(workloads, options);
+        } else if (benchmark == "primitives") {
+            workloads.push_back(generate_random_pairs(generated_workload_size, 3));
+            workloads.push_back(generate_grid_pairs(generated_workload_size, 16, 1));
+            run_primitives(workloads);
+        } else if (benchmark == "cascade") {
+            workloads.push_back(generate_random_pairs(generated_workload_size, 3));
+            workloads.push_back(generate_grid_pairs(generated_workload_size, 16, 1));
+            workloads.push_back(generate_grid_pairs(generated_workload_size, 1 << 20, 2));
+            run_cascade(workloads);
+        } else if (benchmark == "scene") {
+            run_scene(options);
+        } else if (benchmark == "quantized") {
+            workloads.push_back(generate_grid_pairs(generated_workload_size, 16, 1));
+            workloads.push_back(generate_grid_pairs(generated_workload_size, 1 << 20, 2));
+            workloads.push_back(generate_random_pairs(generated_workload_size, 3));
+            run_quantized(workloads, Quantizer(options.resolution));
+        } else {
+            std::cerr << "Unknown benchmark " << benchmark << '\n' << usage;
+            return 1;
+        }
+    } catch (const Exception& e) {
+        std::cerr << e.what() << '\n';
+        return 1;
+    }
+}
@@ -0,0 +1,85 @@
+#include <cmath>
+#include <fstream>
+#include <random>
+
+#include "intersection_of_two_triangles/algorithms/exact_predicates.hpp"
+#include "intersection_of_two_triangles/exception.hpp"
+#include "intersection_of_two_triangles/primitives/quantized_triangle.hpp"
+#include "intersection_of_two_triangles/primitives/vector.hpp"
+
+#include "workloads.hpp"
+
+namespace intersection_of_two_triangles::benchmark {
+
+Workload read_test_file(const char* const path) {
+    std::ifstream in(path);
+    if (!in) {
+        throw Exception(std::string("cannot open ") + path);
+    }
+    Workload result{path, {}, true};
+    TestFileReader reader(in);
+    while (auto test = reader.next()) {
+        result.tests.push_back(*test);
+    }
+    return result;
+}
+
+Workload generate_random_pairs(const size_t count, const unsigned seed) {
+    std::mt19937_64 generator(seed);
+    std::uniform_real_distribution<double> center(0, 10);
+    std::uniform_real_distribution<double> offset(-1, 1);
+    Workload result{"random", {}, false};
+    result.tests.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        const Point c(center(generator), center(generator), center(generator));
+        TestCase test{i + 1};
+        for (GeneralTriangle& gt: test.triangles) {
+            for (Point& vertex: gt.vertices) {
+                vertex = Point(c.x() + offset(generator), c.y() + offset(generator), c.z() + offset(generator));
+            }
+        }
+        result.tests.push_back(test);
+    }
+    return result;
+}
+
+Workload generate_grid_pairs(const size_t count, const std::int64_t grid_size, const unsigned seed) {
+    std::mt19937_64 generator(seed);
+    std::uniform_int_distribution<std::int64_t> coordinate(0, grid_size - 1);
+    const Quantizer quantizer(1);
+    Workload result{"grid", {}, true};
+    result.tests.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        TestCase test{i + 1};
+        for (GeneralTriangle& gt: test.triangles) {
+            for (Point& vertex: gt.vertices) {
+                vertex = Point(static_cast<double>(coordinate(generator)),
+                               static_cast<double>(coordinate(generator)),
+                               static_cast<double>(coordinate(generator)));
+            }
+        }
+        test.expected_answer = are_intersecting(quantizer.quantize(test.triangles[0]),
+                                                quantizer.quantize(test.triangles[1]));
+        result.tests.push_back(test);
+    }
+    return result;
+}
+
+std::vector<GeneralTriangle> generate_triangle_soup(const size_t count, const unsigned seed) {
+    std::mt19937_64 generator(seed);
+    std::uniform_real_distribution<double> center(0, 2 * std::cbrt(static_cast<double>(count)));
+    std::normal_distribution<double> direction(0, 1);
+    std::uniform_real_distribution<double> size(0.9, 1.1);
+    std::vector<GeneralTriangle> result(count);
+    for (GeneralTriangle& gt: result) {
+        const Point c(center(generator), center(generator), center(generator));
+        for (Point& vertex: gt.vertices) {
+            Vector offset(direction(generator), direction(generator), direction(generator));
+            offset *= size(generator) / offset.length();
+            vertex = c + offset;
+        }
+    }
+    return result;
+}
+
+}
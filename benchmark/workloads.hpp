@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "intersection_of_two_triangles/io/test_file_reader.hpp"
+
+namespace intersection_of_two_triangles::benchmark {
+
+struct Workload {
+    std::string name;
+    std::vector<TestCase> tests;
+    // Whether `tests[i].expected_answer` is known. It isn't for random floating-point inputs.
+    bool has_expected_answers;
+};
+
+// Reads all the tests of a file of the format of `tests.txt`. Throws `Exception` if the file is malformed.
+[[nodiscard]] Workload read_test_file(const char* path);
+
+// Pairs of nearby triangles with uniformly distributed vertices, about half of them intersecting.
+[[nodiscard]] Workload generate_random_pairs(size_t count, unsigned seed);
+
+// Pairs of triangles with integer coordinates in [0, grid_size), like the exports of grid-snapped models. Many of them
+// are degenerate, coplanar or touching. The expected answers are computed with the exact predicates.
+[[nodiscard]] Workload generate_grid_pairs(size_t count, std::int64_t grid_size, unsigned seed);
+
+// Randomly oriented triangles of nearly the same size scattered in a cube, like tessellated scan data. The density is
+// such that a triangle intersects a few others on average.
+[[nodiscard]] std::vector<GeneralTriangle> generate_triangle_soup(size_t count, unsigned seed);
+
+}
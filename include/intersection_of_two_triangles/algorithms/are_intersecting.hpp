@@ -1,23 +1,56 @@
 #pragma once
 
+#include <optional>
+
+#include "intersection_of_two_triangles/algorithms/are_nearly_equal.hpp"
+#include "intersection_of_two_triangles/primitives/general_triangle.hpp"
+
 namespace intersection_of_two_triangles {
 
-struct GeneralTriangle;
-struct Point;
+struct Box;
+struct Plane;
 
 class Segment;
 class Triangle;
 
-[[nodiscard]] bool are_intersecting(const GeneralTriangle&, const GeneralTriangle&);
-
-[[nodiscard]] bool are_intersecting(const Point    &, const Point    &);
-[[nodiscard]] bool are_intersecting(const Point    &, const Segment  &);
-[[nodiscard]] bool are_intersecting(const Point    &, const Triangle &);
-[[nodiscard]] bool are_intersecting(const Segment  &, const Point    &);
-[[nodiscard]] bool are_intersecting(const Segment  &, const Segment  &);
-[[nodiscard]] bool are_intersecting(const Segment  &, const Triangle &);
-[[nodiscard]] bool are_intersecting(const Triangle &, const Point    &);
-[[nodiscard]] bool are_intersecting(const Triangle &, const Segment  &);
-[[nodiscard]] bool are_intersecting(const Triangle &, const Triangle &);
+[[nodiscard]] bool are_intersecting(const GeneralTriangle&, const GeneralTriangle&,
+                                    const Tolerance& = default_tolerance);
+// The same for the triangles already decomposed with `GeneralTriangle::as_non_degenerate`.
+[[nodiscard]] bool are_intersecting(const GeneralTriangle::Decomposed&, const GeneralTriangle::Decomposed&,
+                                    const Tolerance& = default_tolerance);
+
+[[nodiscard]] bool are_intersecting(const Point    &, const Point    &, const Tolerance& = default_tolerance);
+[[nodiscard]] bool are_intersecting(const Point    &, const Segment  &, const Tolerance& = default_tolerance);
+[[nodiscard]] bool are_intersecting(const Point    &, const Triangle &, const Tolerance& = default_tolerance);
+[[nodiscard]] bool are_intersecting(const Segment  &, const Point    &, const Tolerance& = default_tolerance);
+[[nodiscard]] bool are_intersecting(const Segment  &, const Segment  &, const Tolerance& = default_tolerance);
+[[nodiscard]] bool are_intersecting(const Segment  &, const Triangle &, const Tolerance& = default_tolerance);
+[[nodiscard]] bool are_intersecting(const Triangle &, const Point    &, const Tolerance& = default_tolerance);
+[[nodiscard]] bool are_intersecting(const Triangle &, const Segment  &, const Tolerance& = default_tolerance);
+[[nodiscard]] bool are_intersecting(const Triangle &, const Triangle &, const Tolerance& = default_tolerance);
+
+// Tests the triangle, which may be degenerate, against the box with the separating axis theorem (Tomas Akenine-Moller,
+// "Fast 3D Triangle-Box Overlap Testing"): the projections onto the normals of the box faces, the normal of
+// the triangle and the cross products of the box axes with the triangle edges must all overlap. The zero axes of
+// degenerate triangles never separate, and the remaining ones are enough for a segment or a point. The projections
+// touching up to `tolerance` overlap, along the normals of the faces also those as close as the points which
+// `are_intersecting` takes as equal, and the rounding of moving the triangle to the center of the box is allowed for.
+[[nodiscard]] bool are_intersecting(const GeneralTriangle&, const Box&, const Tolerance& = default_tolerance);
+
+// The same as `are_intersecting(p, t)`, but reuses `plane`, which must be the plane of `t`.
+[[nodiscard]] bool are_intersecting(const Point& p, const Triangle& t, const Plane& plane,
+                                    const Tolerance& = default_tolerance);
+
+struct SegmentTriangleTestResult {
+    bool intersecting;
+    // The number u such that `s.endpoint(0) + u * s.as_vector()` is the point where the segment crosses the triangle.
+    // It is set only when the segment is intersecting the triangle and isn't parallel to its plane.
+    std::optional<double> parameter;
+};
+
+// The same as `are_intersecting(s, t)`, but reuses `plane`, which must be the plane of `t`.
+[[nodiscard]] SegmentTriangleTestResult test_segment_against_triangle(const Segment& s, const Triangle& t,
+                                                                      const Plane& plane,
+                                                                      const Tolerance& = default_tolerance);
 
 }
@@ -1,7 +1,60 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
 namespace intersection_of_two_triangles {
 
-[[nodiscard]] bool are_nearly_equal(double, double);
+// The tolerance of the comparisons of floating-point numbers: two numbers are nearly equal iff the difference between
+// them is less than `absolute_epsilon` or less than `relative_epsilon` times the sum of their magnitudes.
+//
+// The absolute epsilon is the one of the quantities of degree 2 in the coordinates, such as the squared lengths and
+// the cross products of edges, which most of the compared numbers are. The other quantities are compared with
+// `of_degree(degree)`: the coordinates and the distances are of degree 1, the signed distances to planes with
+// unnormalized normals of degree 3, and so on.
+struct Tolerance {
+    // Returns the tolerance with the given epsilons, the absolute one of degree 2, for inputs whose coordinates are of
+    // the magnitude `coordinate_scale`: the absolute epsilon of every other degree is scaled by the matching power of
+    // it. Throws `Exception` if the epsilons or the scale aren't positive and finite, the relative epsilon isn't less
+    // than 1 or the absolute epsilons of the degrees compared don't fit into doubles.
+    [[nodiscard]] static Tolerance make(double absolute_epsilon, double relative_epsilon, double coordinate_scale = 1);
+    // `make` with the default epsilons, the absolute one multiplied by the square of the scale.
+    [[nodiscard]] static Tolerance for_scale(double coordinate_scale);
+
+    // The same tolerance with the absolute epsilon of the quantities of the given degree from 1 to 5,
+    // `absolute_epsilon * coordinate_scale^(degree - 2)`, which `make` has computed.
+    [[nodiscard]] Tolerance of_degree(int degree) const;
+
+    // The fields are kept consistent by `make`, so they shouldn't be set directly.
+    double absolute_epsilon = 1e-22;
+    double relative_epsilon = std::numeric_limits<double>::epsilon() * 128;
+    double coordinate_scale = 1;
+    // The absolute epsilons of the degrees from 1 to 5.
+    std::array<double, 5> absolute_epsilons{1e-22, 1e-22, 1e-22, 1e-22, 1e-22};
+};
+
+inline constexpr Tolerance default_tolerance{};
+
+inline Tolerance Tolerance::of_degree(const int degree) const {
+    Tolerance result = *this;
+    result.absolute_epsilon = absolute_epsilons[degree - 1];
+    return result;
+}
+
+// The comparisons are defined in the header, since they are called dozens of times per pair of triangles.
+[[nodiscard]] inline bool are_nearly_equal(const double a, const double b,
+                                           const Tolerance& tolerance = default_tolerance) {
+    // The relative epsilon is less than 1, so the sum of the products can't overflow unlike the sum of the magnitudes.
+    const double diff = std::abs(a - b);
+    return diff < std::max(tolerance.absolute_epsilon,
+                           tolerance.relative_epsilon * std::abs(a) + tolerance.relative_epsilon * std::abs(b));
+}
+
+// The same as `are_nearly_equal(0, x)`. Since `relative_epsilon * |x| < |x|`, only the absolute epsilon matters here.
+[[nodiscard]] inline bool is_nearly_zero(const double x, const Tolerance& tolerance = default_tolerance) {
+    return std::abs(x) < tolerance.absolute_epsilon;
+}
 
 }
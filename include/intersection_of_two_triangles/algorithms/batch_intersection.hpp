@@ -0,0 +1,20 @@
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include "intersection_of_two_triangles/algorithms/are_nearly_equal.hpp"
+#include "intersection_of_two_triangles/primitives/general_triangle.hpp"
+
+namespace intersection_of_two_triangles {
+
+using TrianglePair = std::array<GeneralTriangle, 2>;
+
+// Returns `result[i] == are_intersecting(pairs[i][0], pairs[i][1], tolerance)` for all the pairs. Instead of
+// dispatching every pair of sub-objects with `std::visit`, it decomposes all the triangles first, sorts the pairs of
+// sub-objects into buckets by their kinds and checks each bucket in a loop over a single overload, the cheapest
+// buckets first, so that the pairs already known to intersect are skipped in the more expensive ones.
+[[nodiscard]] std::vector<bool> are_intersecting_batch(const std::vector<TrianglePair>& pairs,
+                                                       const Tolerance& = default_tolerance);
+
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "intersection_of_two_triangles/primitives/box.hpp"
+
+namespace intersection_of_two_triangles {
+
+// A binary tree of boxes over a set of primitives given by their bounding boxes. The nodes are stored in depth-first
+// order, so the root is `nodes()[0]` and the left child of an internal node immediately follows it.
+class BoundingVolumeHierarchy {
+public:
+    struct Node {
+        [[nodiscard]] bool is_leaf() const;
+
+        Box box;
+        // For a leaf, the primitives of the node are `primitives()[first] ... primitives()[first + count - 1]`.
+        // For an internal node, `count` is zero and `first` is the index of the right child.
+        size_t first;
+        size_t count;
+    };
+
+    static constexpr size_t max_leaf_size = 4;
+
+    BoundingVolumeHierarchy() = default;
+    explicit BoundingVolumeHierarchy(const std::vector<Box>& primitive_boxes);
+
+    // Recomputes the boxes of the nodes for the moved primitives, keeping the tree. It is linear in the number of nodes,
+    // but the tree may fit the primitives worse than a rebuilt one if they have moved far.
+    void refit(const std::vector<Box>& primitive_boxes);
+
+    [[nodiscard]] bool empty() const;
+    [[nodiscard]] const std::vector<Node>& nodes() const;
+    // Indices into the vector of boxes the hierarchy has been built from.
+    [[nodiscard]] const std::vector<size_t>& primitives() const;
+
+private:
+    size_t build(const std::vector<Box>& primitive_boxes, const std::vector<Point>& centers, size_t first, size_t last);
+
+    std::vector<Node> nodes_;
+    std::vector<size_t> primitives_;
+};
+
+}
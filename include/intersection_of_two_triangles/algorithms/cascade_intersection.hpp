@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "intersection_of_two_triangles/algorithms/are_nearly_equal.hpp"
+#include "intersection_of_two_triangles/algorithms/batch_intersection.hpp"
+
+namespace intersection_of_two_triangles {
+
+struct CascadeStatistics {
+    size_t certified_disjoint = 0;
+    size_t certified_intersecting = 0;
+    // The pairs the filter couldn't decide, which were checked in double precision.
+    size_t rechecked = 0;
+};
+
+// Answers like `are_intersecting_batch`, deciding most pairs with a single-precision filter first. The filter
+// computes the orientations of the vertices of each triangle relative to the plane of the other one and of the pairs
+// of their edges in float, for several pairs at once in the structure-of-arrays layout, so that the compiler
+// vectorizes it. A sign is accepted only when the value exceeds a bound of the rounding errors of the conversion to
+// float and of the arithmetic, widened by the epsilons of `tolerance`. The pair is disjoint if a plane separates the
+// triangles or if no edge crosses the other triangle, and intersecting if an edge crosses it. The pairs with an
+// uncertain sign that matters, e.g. touching, coplanar or degenerate ones, are passed to `are_intersecting_batch`.
+// The certified answers are exact for the given coordinates, so they differ from the double-precision ones only where
+// the epsilons of that path misjudge a pair, e.g. when `tolerance` doesn't suit the scale of the coordinates.
+// The filter pays off only when most pairs are clear of each other: on tests.txt, whose pairs are mostly near the
+// boundary, it certifies 18.5% of them and the cascade runs at about 0.79x the speed of the double-precision path,
+// while on random pairs it certifies almost all of them and is several times faster (see the `cascade` benchmark).
+[[nodiscard]] std::vector<bool> are_intersecting_cascade(const std::vector<TrianglePair>& pairs,
+                                                         const Tolerance& = default_tolerance,
+                                                         CascadeStatistics* = nullptr);
+
+}
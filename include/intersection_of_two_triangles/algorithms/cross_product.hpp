@@ -1,9 +1,12 @@
 #pragma once
 
+#include "intersection_of_two_triangles/algorithms/are_nearly_equal.hpp"
+
 namespace intersection_of_two_triangles {
 
 struct Vector;
 
-[[nodiscard]] Vector cross_product(const Vector&, const Vector&);
+[[nodiscard]] Vector cross_product(const Vector&, const Vector&,
+                                   const Tolerance& = default_tolerance);
 
 }
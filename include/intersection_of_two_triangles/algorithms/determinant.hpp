@@ -2,9 +2,12 @@
 
 #include <array>
 
+#include "intersection_of_two_triangles/algorithms/are_nearly_equal.hpp"
+
 namespace intersection_of_two_triangles {
 
 [[nodiscard]] double determinant(const std::array<double, 2>&,
-                                 const std::array<double, 2>&);
+                                 const std::array<double, 2>&,
+                                 const Tolerance& = default_tolerance);
 
 }
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <utility>
+
+#include "intersection_of_two_triangles/algorithms/are_nearly_equal.hpp"
+#include "intersection_of_two_triangles/algorithms/mesh_index.hpp"
+#include "intersection_of_two_triangles/primitives/general_triangle.hpp"
+#include "intersection_of_two_triangles/primitives/point.hpp"
+
+namespace intersection_of_two_triangles {
+
+struct ClosestPoints {
+    // The point of the first triangle.
+    Point first;
+    // The point of the second triangle.
+    Point second;
+    double distance;
+};
+
+// Finds the closest points of the triangles, which may be degenerate. If the triangles don't intersect, the closest
+// points are a vertex and its projection onto the other triangle or the closest points of two edges. If they do,
+// an edge crosses the other triangle, or those features are at zero distance. All the candidates are computed in
+// plain floating point, without the epsilons of `are_intersecting`.
+[[nodiscard]] ClosestPoints closest_points(const GeneralTriangle&, const GeneralTriangle&);
+[[nodiscard]] double distance(const GeneralTriangle&, const GeneralTriangle&);
+
+// Returns true if the distance between the triangles is at most `d`, comparing the distances with
+// `tolerance.of_degree(1)`. The triangles for which `are_intersecting` is true are within any distance, and those are
+// the only ones within the distance 0. The triangles whose conservative bounding boxes are farther than `d` apart are
+// rejected without computing the distance.
+[[nodiscard]] bool are_within_distance(const GeneralTriangle&, const GeneralTriangle&, double d,
+                                       const Tolerance& = default_tolerance);
+
+struct MeshClosestPoints {
+    // The index of the triangle of the first mesh.
+    size_t first_triangle;
+    // The index of the triangle of the second mesh.
+    size_t second_triangle;
+    ClosestPoints points;
+};
+
+// Finds the closest triangles of the meshes with a branch-and-bound traversal of both hierarchies: the pairs of nodes
+// are visited nearest first and skipped when their boxes are farther apart than the best distance found so far.
+// Returns `std::nullopt` if a mesh is empty.
+[[nodiscard]] std::optional<MeshClosestPoints> closest_points(const MeshIndex&, const MeshIndex&);
+
+// Returns the indices of a pair of triangles of the meshes within the distance `d`, comparing the distances with the
+// tolerance of the first mesh, or `std::nullopt` if there are none. The traversal stops at the first pair found.
+[[nodiscard]] std::optional<std::pair<size_t, size_t>> find_pair_within_distance(const MeshIndex&, const MeshIndex&,
+                                                                                 double d);
+
+}
@@ -1,9 +1,11 @@
 #pragma once
 
+#include "intersection_of_two_triangles/algorithms/are_nearly_equal.hpp"
+
 namespace intersection_of_two_triangles {
 
 struct Vector;
 
-[[nodiscard]] double dot_product(const Vector&, const Vector&);
+[[nodiscard]] double dot_product(const Vector&, const Vector&, const Tolerance& = default_tolerance);
 
 }
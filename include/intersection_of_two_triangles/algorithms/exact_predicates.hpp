@@ -0,0 +1,19 @@
+#pragma once
+
+#include "intersection_of_two_triangles/primitives/quantized_triangle.hpp"
+
+namespace intersection_of_two_triangles {
+
+// The exact predicates over lattice points. They are computed in 128-bit integer arithmetic, which is exact for
+// coordinates bounded by `Quantizer::max_coordinate`, so they need no epsilons.
+
+// Returns the sign of the determinant of `b - a`, `c - a`, `d - a`: positive when `d` is on the side of the plane
+// `abc` towards which `cross_product(b - a, c - a)` points, negative on the other side and zero when it's coplanar.
+[[nodiscard]] int orientation(const LatticePoint& a, const LatticePoint& b, const LatticePoint& c,
+                              const LatticePoint& d);
+
+// Like `are_intersecting(const GeneralTriangle&, const GeneralTriangle&)`, but exact: degenerate triangles are
+// treated as the segments or points they are, without any tolerance.
+[[nodiscard]] bool are_intersecting(const QuantizedTriangle&, const QuantizedTriangle&);
+
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "intersection_of_two_triangles/algorithms/bounding_volume_hierarchy.hpp"
+#include "intersection_of_two_triangles/primitives/box.hpp"
+#include "intersection_of_two_triangles/primitives/general_triangle.hpp"
+#include "intersection_of_two_triangles/primitives/plane.hpp"
+#include "intersection_of_two_triangles/primitives/rigid_transform.hpp"
+#include "intersection_of_two_triangles/primitives/segment.hpp"
+#include "intersection_of_two_triangles/primitives/triangle.hpp"
+
+namespace intersection_of_two_triangles {
+
+struct MeshHit {
+    // The index of the query segment or point.
+    size_t query;
+    // The index of the mesh triangle.
+    size_t triangle;
+    // For segment queries, the number u such that `s.endpoint(0) + u * s.as_vector()` is the hit point.
+    // It isn't set for point queries and when the segment doesn't cross the triangle at a single point.
+    std::optional<double> parameter;
+};
+
+// A set of triangles prepared for many queries: the triangles are decomposed once, the planes of the non-degenerate
+// ones are precomputed and the triangles are put into a bounding volume hierarchy.
+class MeshIndex {
+public:
+    // The number of segments traversing the hierarchy together. The traversal is batched but scalar: the segments of
+    // a batch share the descent, and each box is tested against them one at a time.
+    static constexpr size_t batch_size = 8;
+
+    // All the comparisons done by the queries use `tolerance`. For example, `Tolerance::for_scale(bounds.magnitude())`
+    // can be passed, where `bounds` is the bounding box of the triangles, unless the magnitude is zero, i.e. all the
+    // vertices are at the origin.
+    explicit MeshIndex(std::vector<GeneralTriangle> triangles, const Tolerance& tolerance = default_tolerance);
+
+    [[nodiscard]] const std::vector<GeneralTriangle>& triangles() const;
+    [[nodiscard]] const BoundingVolumeHierarchy& hierarchy() const;
+    [[nodiscard]] const Tolerance& tolerance() const;
+    // The bounding box of `triangles()[which]`, inflated to cover everything the narrow phase treats as touching it.
+    [[nodiscard]] const Box& triangle_box(size_t which) const;
+
+    // Returns all intersecting (segment, triangle) pairs, ordered by the segment index and then by the triangle index.
+    [[nodiscard]] std::vector<MeshHit> intersect(const std::vector<Segment>&) const;
+    // Returns all (point, triangle) pairs such that the triangle contains the point, ordered the same way.
+    [[nodiscard]] std::vector<MeshHit> locate(const std::vector<Point>&) const;
+    // Returns all intersecting pairs of a triangle of this mesh and a triangle of `other` in the lexicographic order,
+    // found by traversing both hierarchies together and compared with the tolerance of this mesh.
+    [[nodiscard]] std::vector<std::pair<size_t, size_t>> intersect(const MeshIndex& other) const;
+    // The same for `other` placed by the transform. Its triangles are transformed only where the hierarchies overlap.
+    [[nodiscard]] std::vector<std::pair<size_t, size_t>> intersect(const MeshIndex& other,
+                                                                    const RigidTransform& other_to_this) const;
+
+private:
+    struct PreparedTriangle {
+        GeneralTriangle::Decomposed sub_objects;
+        // The plane of the only sub-object when it is a triangle.
+        std::optional<Plane> plane;
+    };
+
+    void intersect_batch(const std::vector<Segment>& segments, const size_t* batch, size_t batch_length,
+                         std::vector<MeshHit>& hits) const;
+
+    Tolerance tolerance_;
+    std::vector<GeneralTriangle> triangles_;
+    std::vector<PreparedTriangle> prepared_;
+    std::vector<Box> boxes_;
+    BoundingVolumeHierarchy hierarchy_;
+};
+
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "intersection_of_two_triangles/algorithms/bounding_volume_hierarchy.hpp"
+#include "intersection_of_two_triangles/algorithms/mesh_index.hpp"
+#include "intersection_of_two_triangles/primitives/point.hpp"
+#include "intersection_of_two_triangles/primitives/rigid_transform.hpp"
+#include "intersection_of_two_triangles/primitives/segment.hpp"
+
+namespace intersection_of_two_triangles {
+
+struct SceneHit {
+    // The index of the query segment or point.
+    size_t query;
+    size_t instance;
+    // The index of the triangle of the mesh of the instance.
+    size_t triangle;
+    // Like `MeshHit::parameter`, which the rigid transforms preserve.
+    std::optional<double> parameter;
+};
+
+struct InstanceContact {
+    size_t first_instance;
+    size_t second_instance;
+    // The intersecting pairs of a triangle of the first mesh and a triangle of the second one, ordered.
+    std::vector<std::pair<size_t, size_t>> triangles;
+};
+
+// Instances of meshes placed by rigid transforms, e.g. the parts of an assembly. It is a two-level hierarchy: each
+// mesh keeps its own `MeshIndex`, built once in the coordinates of the mesh and shared by its instances, and the top
+// level is a `BoundingVolumeHierarchy` over the world-space boxes of the instances. The queries find the instances
+// with the top level and transform themselves into the coordinates of the meshes, so moving an instance only refits
+// the top level instead of re-indexing its triangles.
+class Scene {
+public:
+    // Returns the index of the mesh.
+    size_t add_mesh(std::shared_ptr<const MeshIndex>);
+    // Returns the index of the instance. The top level is rebuilt.
+    size_t add_instance(size_t mesh, const RigidTransform& mesh_to_world);
+    // Moves the instance and refits the top level.
+    void set_transform(size_t instance, const RigidTransform& mesh_to_world);
+    // Rebuilds the top level, which fits the instances better than refitting after they have moved far.
+    void rebuild();
+
+    [[nodiscard]] size_t number_of_instances() const;
+    [[nodiscard]] const MeshIndex& mesh_of(size_t instance) const;
+    [[nodiscard]] const RigidTransform& transform(size_t instance) const;
+    [[nodiscard]] const BoundingVolumeHierarchy& top_level() const;
+
+    // Like `MeshIndex::intersect` and `MeshIndex::locate` over all the instances, ordered by the query index, then by
+    // the instance and by the triangle. The comparisons use the tolerances of the meshes. Transforming a query rounds
+    // it, so a point lying on a triangle in world space is located only if the absolute epsilon absorbs that.
+    [[nodiscard]] std::vector<SceneHit> intersect(const std::vector<Segment>&) const;
+    [[nodiscard]] std::vector<SceneHit> locate(const std::vector<Point>&) const;
+    // Returns the pairs of instances `first < second` whose triangles intersect, ordered. The triangles of the second
+    // instance are transformed into the coordinates of the mesh of the first one.
+    [[nodiscard]] std::vector<InstanceContact> find_intersecting_instances() const;
+
+private:
+    struct Instance {
+        size_t mesh;
+        RigidTransform mesh_to_world;
+        RigidTransform world_to_mesh;
+    };
+
+    // Calls `visit(instance)` for the instances whose boxes intersect `box`.
+    template<class Visit>
+    void for_each_instance_overlapping(const Box& box, Visit&& visit) const;
+
+    std::vector<std::shared_ptr<const MeshIndex>> meshes_;
+    std::vector<Instance> instances_;
+    std::vector<Box> instance_boxes_;
+    BoundingVolumeHierarchy top_level_;
+};
+
+}
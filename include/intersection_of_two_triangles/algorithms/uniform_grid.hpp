@@ -0,0 +1,73 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "intersection_of_two_triangles/algorithms/are_nearly_equal.hpp"
+#include "intersection_of_two_triangles/primitives/box.hpp"
+#include "intersection_of_two_triangles/primitives/general_triangle.hpp"
+#include "intersection_of_two_triangles/utility/parallel_for.hpp"
+
+namespace intersection_of_two_triangles {
+
+// A broad phase for triangles of similar sizes, e.g. tessellated scans. The space is divided into cubic cells, and
+// each triangle is put into a hash table under every cell its bounding box overlaps. Unlike a tree, it is built in
+// a few linear passes, and it takes memory proportional to the number of (cell, triangle) entries.
+class UniformGrid {
+public:
+    // The triangles overlapping more cells are kept aside and checked against all the other triangles.
+    static constexpr size_t max_cells_per_triangle = 4096;
+
+    // Builds the grid in parallel. When `cell_size` is zero, it is the average of the largest extents of the bounding
+    // boxes of the triangles, so a triangle of the typical size overlaps at most 8 cells.
+    explicit UniformGrid(const std::vector<GeneralTriangle>& triangles, const Tolerance& = default_tolerance,
+                         size_t threads = default_number_of_threads(), double cell_size = 0);
+
+    [[nodiscard]] double cell_size() const;
+    [[nodiscard]] size_t number_of_entries() const;
+
+    // Calls `visitor(thread, a, b)` exactly once for each pair of triangles `a < b` whose bounding boxes intersect.
+    // The pair is reported only from the cell which contains the minimal corner of the intersection of the boxes,
+    // so the pairs sharing several cells aren't duplicated. `thread` is the index of the calling thread.
+    void for_each_candidate_pair(size_t threads,
+                                 const std::function<void(size_t thread, size_t a, size_t b)>& visitor) const;
+
+private:
+    using Cell = std::array<std::int64_t, 3>;
+
+    struct Entry {
+        Cell cell;
+        size_t triangle;
+    };
+
+    [[nodiscard]] Cell cell_of(const Point&) const;
+
+    double cell_size_;
+    std::vector<Box> boxes_;
+    // The entries of the hash bucket `i` are `entries_[bucket_offsets_[i]] ... entries_[bucket_offsets_[i + 1] - 1]`.
+    std::vector<size_t> bucket_offsets_;
+    std::vector<Entry> entries_;
+    std::vector<size_t> oversized_;
+};
+
+// Returns all pairs of intersecting triangles `(a, b)`, `a < b`, in the lexicographic order, finding them with
+// `UniformGrid` and checking the candidates with `are_intersecting` in parallel. When `filter` is given, only the
+// candidates for which `filter(a, b)` is true are checked, e.g. to skip the adjacent faces of a mesh.
+[[nodiscard]] std::vector<std::pair<size_t, size_t>> find_intersecting_pairs(
+    const std::vector<GeneralTriangle>& triangles, const Tolerance& = default_tolerance,
+    size_t threads = default_number_of_threads(), const std::function<bool(size_t a, size_t b)>& filter = nullptr);
+
+// Returns the label of the cluster of mutually intersecting triangles of each triangle: the connected components of
+// the graph whose edges are the intersecting pairs, labeled with their least triangle indices. The candidates of
+// `UniformGrid` are checked in parallel and merged on the fly into `ConcurrentDisjointSets`, skipping the pairs which
+// are already in the same component, so the memory is proportional to the number of triangles rather than the number
+// of intersecting pairs.
+[[nodiscard]] std::vector<size_t> find_intersecting_components(const std::vector<GeneralTriangle>& triangles,
+                                                               const Tolerance& = default_tolerance,
+                                                               size_t threads = default_number_of_threads());
+
+}
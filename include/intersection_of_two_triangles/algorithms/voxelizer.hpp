@@ -0,0 +1,48 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "intersection_of_two_triangles/algorithms/are_nearly_equal.hpp"
+#include "intersection_of_two_triangles/primitives/box.hpp"
+#include "intersection_of_two_triangles/primitives/general_triangle.hpp"
+#include "intersection_of_two_triangles/primitives/point.hpp"
+#include "intersection_of_two_triangles/utility/parallel_for.hpp"
+
+namespace intersection_of_two_triangles {
+
+// A regular grid of cubic cells: the cell (i, j, k) spans `origin + (i, j, k) * cell_size` to
+// `origin + (i + 1, j + 1, k + 1) * cell_size`.
+struct VoxelGrid {
+    using Cell = std::array<size_t, 3>;
+
+    // The grid with cells of the given size covering the bounding box of the triangles.
+    [[nodiscard]] static VoxelGrid around(const std::vector<GeneralTriangle>& triangles, double cell_size);
+
+    [[nodiscard]] size_t number_of_cells() const;
+    [[nodiscard]] Box cell_box(const Cell&) const;
+    // The cells are numbered along x first, then y, then z.
+    [[nodiscard]] size_t index(const Cell&) const;
+    [[nodiscard]] Cell cell(size_t index) const;
+
+    Point origin;
+    double cell_size = 1;
+    std::array<size_t, 3> dimensions{};
+};
+
+// Marks the cells touched by the triangles, testing them with `are_intersecting(GeneralTriangle, Box)`. The layers of
+// cells along z are rasterized in parallel, each by a single thread, so the threads don't share cells. Returns one
+// byte per cell, indexed with `VoxelGrid::index`, set to 1 for the touched cells.
+[[nodiscard]] std::vector<std::uint8_t> voxelize_dense(const std::vector<GeneralTriangle>& triangles,
+                                                       const VoxelGrid& grid, const Tolerance& = default_tolerance,
+                                                       size_t threads = default_number_of_threads());
+
+// The same as `voxelize_dense`, but returns the indices of the touched cells in increasing order, taking memory
+// proportional to their number rather than to the size of the grid.
+[[nodiscard]] std::vector<size_t> voxelize_sparse(const std::vector<GeneralTriangle>& triangles,
+                                                  const VoxelGrid& grid, const Tolerance& = default_tolerance,
+                                                  size_t threads = default_number_of_threads());
+
+}
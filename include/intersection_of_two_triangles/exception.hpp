@@ -1,3 +1,5 @@
+#pragma once
+
 #include <stdexcept>
 
 namespace intersection_of_two_triangles {
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "intersection_of_two_triangles/algorithms/batch_intersection.hpp"
+#include "intersection_of_two_triangles/algorithms/mesh_index.hpp"
+#include "intersection_of_two_triangles/io/protocol.hpp"
+#include "intersection_of_two_triangles/primitives/general_triangle.hpp"
+#include "intersection_of_two_triangles/primitives/segment.hpp"
+
+namespace intersection_of_two_triangles {
+
+// A connection to a `Server`. The methods send one request each and wait for the answer. They throw `Exception`
+// with the message of the server if it rejects the request, or if the connection fails.
+class Client {
+public:
+    explicit Client(const std::string& socket_path);
+    ~Client();
+    Client(const Client&) = delete;
+    Client& operator=(const Client&) = delete;
+
+    [[nodiscard]] MeshId upload_mesh(const std::vector<GeneralTriangle>&);
+    // The path is opened by the server.
+    [[nodiscard]] MeshId load_mesh_file(const std::string& path);
+    void drop_mesh(MeshId);
+
+    [[nodiscard]] std::vector<bool> are_intersecting(const std::vector<TrianglePair>&);
+    // Like `MeshIndex::intersect` of the first mesh with the second one.
+    [[nodiscard]] std::vector<std::pair<size_t, size_t>> intersect(MeshId first, MeshId second);
+    // Like `MeshIndex::intersect` of the mesh with the segments.
+    [[nodiscard]] std::vector<MeshHit> intersect(MeshId, const std::vector<Segment>&);
+
+private:
+    // Returns the payload of the response, which is valid until the next call.
+    [[nodiscard]] std::string_view call(Request, std::string_view payload);
+
+    int descriptor_;
+    std::string response_;
+};
+
+}
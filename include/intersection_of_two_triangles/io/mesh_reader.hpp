@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include "intersection_of_two_triangles/primitives/mesh.hpp"
+#include "intersection_of_two_triangles/utility/parallel_for.hpp"
+
+namespace intersection_of_two_triangles {
+
+// Reads a binary or an ASCII STL file. The binary files are memory-mapped and their records are converted in
+// parallel. The corners of the facets are welded exactly, so the facets sharing a vertex share its index.
+// Throws `Exception` if the file can't be read or is malformed.
+[[nodiscard]] Mesh read_stl(const std::string& path, size_t threads = default_number_of_threads());
+
+// Reads the vertices (`v`) and the faces (`f`) of a Wavefront OBJ file and ignores the other statements. The file is
+// memory-mapped and split at line breaks into chunks which are parsed in parallel. The polygons are triangulated as
+// fans, the texture and normal indices are ignored, and the negative indices are relative to the last vertex.
+// Throws `Exception` if the file can't be read or is malformed.
+[[nodiscard]] Mesh read_obj(const std::string& path, size_t threads = default_number_of_threads());
+
+// Calls `read_stl` or `read_obj` depending on the extension of the file.
+[[nodiscard]] Mesh read_mesh(const std::string& path, size_t threads = default_number_of_threads());
+
+}
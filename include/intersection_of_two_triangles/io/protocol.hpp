@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "intersection_of_two_triangles/exception.hpp"
+
+namespace intersection_of_two_triangles {
+
+// The binary protocol of `Server`. Every message is a frame: a `FrameHeader` followed by `size` bytes of payload.
+// The numbers are in the byte order of the host, since the server and its clients share the machine. A client sends
+// a request frame and receives a response frame whose type is a `Status`; the requests of a connection are answered
+// in order, and several connections are served concurrently.
+struct FrameHeader {
+    std::uint64_t type;
+    std::uint64_t size;
+};
+
+using MeshId = std::uint64_t;
+
+enum class Request : std::uint64_t {
+    // u64 n, n × 9 doubles (the vertices of the triangles) -> `MeshId`
+    upload_mesh = 1,
+    // the path of an STL or OBJ file readable by the server -> `MeshId`
+    load_mesh_file = 2,
+    // `MeshId` -> nothing. The queries already running on the mesh finish normally.
+    drop_mesh = 3,
+    // u64 n, n × 18 doubles (the vertices of the pairs of triangles) -> n bytes, 1 if the pair intersects
+    check_pairs = 4,
+    // `MeshId` first, `MeshId` second -> u64 n, n × (u64 first triangle, u64 second triangle)
+    intersect_meshes = 5,
+    // `MeshId`, u64 n, n × 6 doubles (the endpoints of the segments) -> u64 n, n × (u64 segment, u64 triangle,
+    // double parameter of the hit point or NaN), ordered like `MeshIndex::intersect`
+    intersect_segments = 6,
+};
+
+enum class Status : std::uint64_t {
+    ok = 0,
+    // The payload is the message. The connection stays open.
+    error = 1,
+};
+
+// Larger frames are rejected before their payload is read, e.g. uploads of more than 3.7 million triangles, whose
+// meshes should be loaded from files instead.
+inline constexpr std::uint64_t max_frame_size = std::uint64_t{256} << 20;
+
+// Sends the frame, retrying partial writes. Throws `Exception` on failure.
+void write_frame(int descriptor, std::uint64_t type, std::string_view payload);
+// Receives a frame into `payload`, which grows as the bytes arrive, so a header announcing a large frame doesn't
+// allocate its size up front. Returns `std::nullopt` if the peer has closed the connection before the frame.
+// Throws `Exception` on failure or if the connection breaks inside the frame.
+[[nodiscard]] std::optional<std::uint64_t> read_frame(int descriptor, std::string& payload);
+
+template<class T>
+void append(std::string& payload, const T& value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    payload.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+// Reads the fields of a payload in order. Throws `Exception` if the payload is too short.
+class PayloadReader {
+public:
+    explicit PayloadReader(const std::string_view payload) : payload_(payload) {}
+
+    template<class T>
+    [[nodiscard]] T read() {
+        static_assert(std::is_trivially_copyable_v<T>);
+        T result;
+        std::memcpy(&result, take(sizeof(T)).data(), sizeof(T));
+        return result;
+    }
+
+    // Reads a count of items of `item_size` bytes, checking that the payload holds them.
+    [[nodiscard]] std::uint64_t read_count(const size_t item_size) {
+        const auto count = read<std::uint64_t>();
+        if (count > payload_.size() / item_size) {
+            throw Exception("the payload is shorter than its count of items");
+        }
+        return count;
+    }
+
+    [[nodiscard]] std::string_view take(const size_t size) {
+        if (payload_.size() < size) {
+            throw Exception("the payload is too short");
+        }
+        const std::string_view result = payload_.substr(0, size);
+        payload_.remove_prefix(size);
+        return result;
+    }
+
+    [[nodiscard]] std::string_view rest() const {
+        return payload_;
+    }
+
+private:
+    std::string_view payload_;
+};
+
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+#include "intersection_of_two_triangles/algorithms/are_nearly_equal.hpp"
+#include "intersection_of_two_triangles/primitives/general_triangle.hpp"
+
+namespace intersection_of_two_triangles {
+
+// Increment it when a change of the algorithms may change their answers: it's a part of the keys of `ResultCache`,
+// so the answers of the previous versions aren't reused.
+inline constexpr std::uint64_t algorithm_version = 3;
+
+// The pair with the vertices of each triangle rotated to start with the lexicographically least sequence, and the
+// triangles ordered the same way. The rotated and swapped variants of a pair have the same canonical pair.
+[[nodiscard]] std::array<GeneralTriangle, 2> canonical_pair(const GeneralTriangle&, const GeneralTriangle&);
+
+// The settings the answers depend on.
+struct CacheContext {
+    Tolerance tolerance;
+    // The resolution of the lattice of the quantized mode, or 0 if the triangles aren't quantized.
+    double resolution = 0;
+};
+
+// A persistent hash table from pairs of triangles to the answers of `are_intersecting`, stored in a memory-mapped
+// file. It's an open-addressing table with linear probing, doubled by rewriting the file once it's half full.
+// The file is locked while it's open, so it can't be used by two processes at once.
+class ResultCache {
+public:
+    // 128 bits of a hash of the canonical pair, the settings and `algorithm_version`.
+    using Key = std::array<std::uint64_t, 2>;
+
+    // Opens or creates the file. Throws `Exception` if it can't be mapped, is locked or isn't a cache of this format.
+    explicit ResultCache(std::string path);
+    ~ResultCache();
+    ResultCache(const ResultCache&) = delete;
+    ResultCache& operator=(const ResultCache&) = delete;
+
+    [[nodiscard]] static Key key(const std::array<GeneralTriangle, 2>& canonical_pair, const CacheContext&);
+
+    [[nodiscard]] std::optional<bool> find(const Key&) const;
+    // Throws `Exception` if the file can't be grown.
+    void insert(const Key&, bool answer);
+
+    [[nodiscard]] size_t size() const;
+    [[nodiscard]] size_t capacity() const;
+
+private:
+    struct Header;
+    struct Slot;
+
+    [[nodiscard]] Header& header() const;
+    [[nodiscard]] Slot* slots() const;
+    [[nodiscard]] static Slot* slots(void* data);
+    // Inserts into the table mapped at `data`, which has a free slot.
+    static void insert(void* data, const Key&, std::uint64_t value);
+    void map(int descriptor, std::uint64_t capacity, bool initialize);
+    void unmap();
+    void grow();
+
+    std::string path_;
+    int descriptor_ = -1;
+    void* data_ = nullptr;
+    size_t bytes_ = 0;
+};
+
+}
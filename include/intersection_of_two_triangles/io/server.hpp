@@ -0,0 +1,64 @@
+#pragma once
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+#include "intersection_of_two_triangles/algorithms/are_nearly_equal.hpp"
+#include "intersection_of_two_triangles/algorithms/mesh_index.hpp"
+#include "intersection_of_two_triangles/io/protocol.hpp"
+
+namespace intersection_of_two_triangles {
+
+// Answers the requests of `protocol.hpp` on a Unix domain socket, so the clients don't pay for starting a process and
+// loading the meshes for every query. The uploaded meshes are kept as `MeshIndex`es shared by all the connections
+// until they are dropped. Each connection is served by its own thread.
+class Server {
+public:
+    // Listens on the socket, replacing a stale socket file nobody listens on, until the server is destroyed.
+    // Throws `Exception` on failure.
+    Server(std::string socket_path, const Tolerance& = default_tolerance);
+    ~Server();
+    Server(const Server&) = delete;
+    Server& operator=(const Server&) = delete;
+
+    // Accepts and serves the connections until `stop` is called, then closes them.
+    void run();
+    // Makes `run` return. It is async-signal-safe, so it may be called from a signal handler.
+    void stop();
+
+private:
+    struct Connection {
+        int descriptor;
+        std::thread thread;
+        std::atomic<bool> finished{false};
+    };
+
+    void serve(Connection&);
+    [[nodiscard]] std::string answer(std::uint64_t type, std::string_view payload);
+    [[nodiscard]] std::shared_ptr<const MeshIndex> mesh(MeshId) const;
+    [[nodiscard]] MeshId add_mesh(std::shared_ptr<const MeshIndex>);
+    // Joins the threads of the finished connections, or of all connections, and closes their sockets. The caller must
+    // hold `connections_mutex_`.
+    void reap_connections(bool all);
+
+    std::string socket_path_;
+    Tolerance tolerance_;
+    int listener_ = -1;
+    // `stop` writes to `wake_[1]` to interrupt `poll` in `run`.
+    int wake_[2] = {-1, -1};
+
+    mutable std::shared_mutex meshes_mutex_;
+    std::unordered_map<MeshId, std::shared_ptr<const MeshIndex>> meshes_;
+    MeshId next_mesh_id_ = 1;
+
+    std::mutex connections_mutex_;
+    std::list<Connection> connections_;
+};
+
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <limits>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "intersection_of_two_triangles/exception.hpp"
+#include "intersection_of_two_triangles/primitives/general_triangle.hpp"
+
+namespace intersection_of_two_triangles {
+
+struct TestCase {
+    // The index of the line with the expected answer.
+    size_t line_index;
+    std::array<GeneralTriangle, 2> triangles;
+    bool expected_answer;
+};
+
+// Thrown by `TestFileReader` if the input is malformed. The message is prefixed with the line index.
+class ParseError : public Exception {
+public:
+    ParseError(size_t line_index, const std::string& reason);
+
+    [[nodiscard]] size_t line_index() const;
+    [[nodiscard]] const std::string& reason() const;
+
+private:
+    size_t line_index_;
+    std::string reason_;
+};
+
+// Reads the test files of the format of `tests.txt`: the coordinates of the vertices of two triangles followed by
+// a line containing the expected answer, `true` or `false`. A line with less than 9 numbers is a triangle whose
+// missing vertices are equal to its first vertex. Lines starting with '#' are comments.
+class TestFileReader {
+public:
+    // Reads at most `length` bytes, which must end at the end of a line.
+    explicit TestFileReader(std::istream& in, size_t first_line_index = 1,
+                            std::uint64_t length = std::numeric_limits<std::uint64_t>::max());
+
+    // Returns `std::nullopt` at the end of the input. Throws `ParseError` if the input is malformed.
+    [[nodiscard]] std::optional<TestCase> next();
+    // The index of the last line read.
+    [[nodiscard]] size_t line_index() const;
+
+private:
+    void parse_numbers();
+
+    std::istream& in_;
+    std::string line_;
+    std::vector<double> input_;
+    size_t line_index_;
+    std::uint64_t bytes_left_;
+};
+
+struct ByteRange {
+    std::uint64_t begin;
+    std::uint64_t end;
+};
+
+// Splits the test file into at most `count` byte ranges of about equal sizes, which can be read independently with
+// `TestFileReader`: every range except the last one ends at the end of the line with an expected answer.
+[[nodiscard]] std::vector<ByteRange> split_into_ranges(std::istream& in, size_t count);
+
+}
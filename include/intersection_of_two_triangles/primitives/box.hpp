@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+
+#include "intersection_of_two_triangles/algorithms/are_nearly_equal.hpp"
+#include "intersection_of_two_triangles/primitives/point.hpp"
+
+namespace intersection_of_two_triangles {
+
+struct GeneralTriangle;
+
+// An axis-aligned bounding box. A default-constructed box is empty: it contains no points and expanding it by a point
+// yields the box of that single point.
+struct Box {
+    Box();
+    Box(const Point& min, const Point& max);
+
+    [[nodiscard]] bool is_empty() const;
+    [[nodiscard]] bool contains(const Point&) const;
+    [[nodiscard]] Point center() const;
+    [[nodiscard]] double extent(size_t which) const;
+    [[nodiscard]] size_t longest_axis() const;
+    // The largest absolute value of the coordinates of the points of the box.
+    [[nodiscard]] double magnitude() const;
+    [[nodiscard]] Box inflated(double margin) const;
+
+    void expand(const Point&);
+    void expand(const Box&);
+
+    Point min, max;
+};
+
+[[nodiscard]] bool are_intersecting(const Box&, const Box&);
+// The least distance between the points of the boxes: zero if they intersect, infinity if one of them is empty.
+[[nodiscard]] double distance(const Box&, const Box&);
+
+[[nodiscard]] Box bounding_box(const GeneralTriangle&);
+
+// The algorithms treat numbers as equal up to the epsilons of the tolerance, so an object can touch a triangle slightly
+// outside of its exact bounding box. This box is inflated to cover all such objects.
+[[nodiscard]] Box conservative_bounding_box(const GeneralTriangle&, const Tolerance& = default_tolerance);
+
+}
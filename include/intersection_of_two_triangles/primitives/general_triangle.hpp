@@ -14,8 +14,8 @@ class Triangle;
 
 struct GeneralTriangle {
     using Decomposed = std::vector<std::variant<Point, Segment, Triangle>>;
-    [[nodiscard]] Decomposed as_non_degenerate() const;
-    [[nodiscard]] Segment edge(size_t which) const;
+    [[nodiscard]] Decomposed as_non_degenerate(const Tolerance& = default_tolerance) const;
+    [[nodiscard]] Segment edge(size_t which, const Tolerance& = default_tolerance) const;
 
     std::array<Point, 3> vertices;
 };
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include "intersection_of_two_triangles/primitives/general_triangle.hpp"
+#include "intersection_of_two_triangles/primitives/point.hpp"
+
+namespace intersection_of_two_triangles {
+
+// A triangle mesh whose faces are triples of indices into the shared vertices.
+struct Mesh {
+    using Face = std::array<size_t, 3>;
+
+    [[nodiscard]] GeneralTriangle triangle(size_t which) const;
+    [[nodiscard]] std::vector<GeneralTriangle> triangles() const;
+    // Returns true if the faces share a vertex, so they touch at least there.
+    [[nodiscard]] bool are_adjacent(size_t face1, size_t face2) const;
+
+    std::vector<Point> vertices;
+    std::vector<Face> faces;
+};
+
+// Merges each vertex into an earlier kept vertex closer than `distance` to it, or equal to it when `distance` is zero,
+// and renumbers the faces. The faces may become degenerate.
+void weld_vertices(Mesh&, double distance = 0);
+
+}
@@ -12,14 +12,16 @@ struct Point;
 
 // The equation is dot_product(normal, point) + d = 0.
 struct Plane {
-    Plane(const Point&, const Point&, const Point&);
+    Plane(const Point&, const Point&, const Point&, const Tolerance& = default_tolerance);
 
-    [[nodiscard]] double signed_distance(const Point& to) const;
+    // The distance times the length of the normal, which is of degree 3 in the coordinates.
+    [[nodiscard]] double signed_distance(const Point& to, const Tolerance& = default_tolerance) const;
 
     Vector normal;
     double d;
 };
 
-[[nodiscard]] std::optional<Line> intersection(const Plane&, const Plane&);
+[[nodiscard]] std::optional<Line> intersection(const Plane&, const Plane&,
+                                               const Tolerance& = default_tolerance);
 
 }
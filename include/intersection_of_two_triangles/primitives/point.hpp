@@ -1,20 +1,28 @@
 #pragma once
 
+#include <array>
 #include <cstddef>
 
-namespace intersection_of_two_triangles {
+#include "intersection_of_two_triangles/algorithms/are_nearly_equal.hpp"
+#include "intersection_of_two_triangles/primitives/vector.hpp"
 
-struct Vector;
+namespace intersection_of_two_triangles {
 
+// Stored like `Vector`, and its arithmetic is inline for the same reason.
 struct Point {
     Point() = default;
     Point(double x, double y, double z);
 
     [[nodiscard]] Vector radius_vector() const;
-    [[nodiscard]] double coord(size_t which) const;
-    [[nodiscard]] double& coord(size_t which);
 
-    double x{}, y{}, z{};
+    [[nodiscard]] double operator[](size_t which) const;
+    [[nodiscard]] double& operator[](size_t which);
+    [[nodiscard]] double x() const;
+    [[nodiscard]] double y() const;
+    [[nodiscard]] double z() const;
+
+private:
+    std::array<double, 3> coords_{};
 };
 
 [[nodiscard]] Vector operator-(const Point&, const Point&);
@@ -22,9 +30,47 @@ struct Point {
 [[nodiscard]] Point operator+(const Point&, const Vector&);
 [[nodiscard]] Point operator-(const Point&, const Vector&);
 
-[[nodiscard]] bool are_nearly_equal(const Point&, const Point&);
+[[nodiscard]] bool are_nearly_equal(const Point&, const Point&, const Tolerance& = default_tolerance);
 [[nodiscard]] bool are_exactly_equal(const Point&, const Point&);
 
 [[nodiscard]] double distance(const Point&, const Point&);
 
+inline Point::Point(const double x, const double y, const double z) : coords_{x, y, z} {}
+
+inline Vector Point::radius_vector() const {
+    return {coords_[0], coords_[1], coords_[2]};
+}
+
+inline double Point::operator[](const size_t which) const {
+    return coords_[which];
+}
+
+inline double& Point::operator[](const size_t which) {
+    return coords_[which];
+}
+
+inline double Point::x() const {
+    return coords_[0];
+}
+
+inline double Point::y() const {
+    return coords_[1];
+}
+
+inline double Point::z() const {
+    return coords_[2];
+}
+
+inline Vector operator-(const Point& a, const Point& b) {
+    return {a[0] - b[0], a[1] - b[1], a[2] - b[2]};
+}
+
+inline Point operator+(const Point& p, const Vector& v) {
+    return {p[0] + v[0], p[1] + v[1], p[2] + v[2]};
+}
+
+inline Point operator-(const Point& p, const Vector& v) {
+    return {p[0] - v[0], p[1] - v[1], p[2] - v[2]};
+}
+
 }
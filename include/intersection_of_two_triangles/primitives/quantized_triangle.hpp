@@ -0,0 +1,45 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "intersection_of_two_triangles/primitives/point.hpp"
+
+namespace intersection_of_two_triangles {
+
+struct GeneralTriangle;
+
+// A point with integer coordinates: the point `x * resolution, y * resolution, z * resolution` of a `Quantizer`.
+struct LatticePoint {
+    std::int64_t x, y, z;
+};
+
+[[nodiscard]] bool operator==(const LatticePoint&, const LatticePoint&);
+
+struct QuantizedTriangle {
+    std::array<LatticePoint, 3> vertices;
+};
+
+// Maps points to the nearest points of the lattice with the given step. The coordinates of the lattice points are
+// bounded by `max_coordinate`, so that the exact predicates never overflow 128-bit integers.
+class Quantizer {
+public:
+    static constexpr std::int64_t max_coordinate = std::int64_t{1} << 40;
+
+    explicit Quantizer(double resolution);
+
+    [[nodiscard]] double resolution() const;
+
+    // Throws `Exception` if the point is too far from the origin to be represented.
+    [[nodiscard]] LatticePoint quantize(const Point&) const;
+    [[nodiscard]] QuantizedTriangle quantize(const GeneralTriangle&) const;
+    [[nodiscard]] Point restore(const LatticePoint&) const;
+
+    // Returns true iff the point is exactly a lattice point, i.e. quantizing it loses nothing.
+    [[nodiscard]] bool is_on_lattice(const Point&) const;
+
+private:
+    double resolution_;
+};
+
+}
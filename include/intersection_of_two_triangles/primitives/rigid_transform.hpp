@@ -0,0 +1,35 @@
+#pragma once
+
+#include <array>
+
+#include "intersection_of_two_triangles/primitives/box.hpp"
+#include "intersection_of_two_triangles/primitives/general_triangle.hpp"
+#include "intersection_of_two_triangles/primitives/point.hpp"
+#include "intersection_of_two_triangles/primitives/segment.hpp"
+#include "intersection_of_two_triangles/primitives/vector.hpp"
+
+namespace intersection_of_two_triangles {
+
+// A rotation followed by a translation: maps `p` to `rotation * p + translation`. The rotation matrix is assumed to be
+// orthonormal, so the inverse is its transpose, and distances and segment parameters are preserved.
+struct RigidTransform {
+    // Rotates by `angle` radians counterclockwise about `axis`, which must be nonzero, and then translates.
+    [[nodiscard]] static RigidTransform rotation(const Vector& axis, double angle, const Vector& translation = {});
+
+    [[nodiscard]] Point operator()(const Point&) const;
+    [[nodiscard]] Vector operator()(const Vector&) const;
+    [[nodiscard]] GeneralTriangle operator()(const GeneralTriangle&) const;
+    [[nodiscard]] Segment operator()(const Segment&, const Tolerance& = default_tolerance) const;
+    // The bounding box of the transformed box, inflated by the rounding errors of transforming its points.
+    [[nodiscard]] Box operator()(const Box&) const;
+
+    [[nodiscard]] RigidTransform inverse() const;
+
+    std::array<Vector, 3> rotation_rows{Vector(1, 0, 0), Vector(0, 1, 0), Vector(0, 0, 1)};
+    Vector translation;
+};
+
+// The transform applying `second` after `first`.
+[[nodiscard]] RigidTransform operator*(const RigidTransform& second, const RigidTransform& first);
+
+}
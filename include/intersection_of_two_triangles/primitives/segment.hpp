@@ -10,7 +10,7 @@ struct Vector;
 
 class Segment {
 public:
-    Segment(const Point&, const Point&);
+    Segment(const Point&, const Point&, const Tolerance& = default_tolerance);
     [[nodiscard]] const Point& endpoint(bool which) const;
     [[nodiscard]] Vector as_vector() const;
 
@@ -11,11 +11,11 @@ class Segment;
 
 class Triangle {
 public:
-    Triangle(const Point&, const Point&, const Point&);
+    Triangle(const Point&, const Point&, const Point&, const Tolerance& = default_tolerance);
     [[nodiscard]] const Point& vertex(size_t which) const;
 
     // Returns the triangle side opposite to `vertex(which)`.
-    [[nodiscard]] Segment edge(size_t which) const;
+    [[nodiscard]] Segment edge(size_t which, const Tolerance& = default_tolerance) const;
 
 private:
     std::array<Point, 3> vertices;
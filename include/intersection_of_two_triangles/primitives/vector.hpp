@@ -1,33 +1,119 @@
 #pragma once
 
+#include <array>
 #include <cstddef>
 
+#include "intersection_of_two_triangles/algorithms/are_nearly_equal.hpp"
+
 namespace intersection_of_two_triangles {
 
 struct Point;
 
+// The coordinates are stored in an array, so indexing them is a plain load, and the arithmetic is defined inline
+// as loops over the coordinates, which the compiler fuses and vectorizes in the inner loops of the algorithms.
+// The array isn't over-aligned: padding the coordinates to 32 bytes grows every triangle, box and hierarchy node by a
+// third, which costs more in memory traffic than the aligned loads gain.
 struct Vector {
+    Vector() = default;
     Vector(double x, double y, double z);
 
     [[nodiscard]] Point as_point() const;
-    [[nodiscard]] bool is_zero() const;
-    [[nodiscard]] double coord(size_t which) const;
-    [[nodiscard]] double& coord(size_t which);
+    // The tolerance must be the one of the degree of the coordinates, e.g. `of_degree(4)` for the cross product of two
+    // normals.
+    [[nodiscard]] bool is_zero(const Tolerance& = default_tolerance) const;
     [[nodiscard]] double length() const;
 
+    [[nodiscard]] double operator[](size_t which) const;
+    [[nodiscard]] double& operator[](size_t which);
+    [[nodiscard]] double x() const;
+    [[nodiscard]] double y() const;
+    [[nodiscard]] double z() const;
+
     Vector& operator+=(const Vector&);
     Vector& operator-=(const Vector&);
     Vector& operator*=(double);
     Vector& operator/=(double);
 
-    double x, y, z;
+private:
+    std::array<double, 3> coords_{};
 };
 
 [[nodiscard]] Vector operator-(Vector);
-[[nodiscard]] Vector operator-(Vector, Vector);
-[[nodiscard]] Vector operator+(Vector, Vector);
+[[nodiscard]] Vector operator-(Vector, const Vector&);
+[[nodiscard]] Vector operator+(Vector, const Vector&);
 [[nodiscard]] Vector operator*(double, Vector);
 [[nodiscard]] Vector operator*(Vector, double);
 [[nodiscard]] Vector operator/(Vector, double);
 
+inline Vector::Vector(const double x, const double y, const double z) : coords_{x, y, z} {}
+
+inline double Vector::operator[](const size_t which) const {
+    return coords_[which];
+}
+
+inline double& Vector::operator[](const size_t which) {
+    return coords_[which];
+}
+
+inline double Vector::x() const {
+    return coords_[0];
+}
+
+inline double Vector::y() const {
+    return coords_[1];
+}
+
+inline double Vector::z() const {
+    return coords_[2];
+}
+
+inline Vector& Vector::operator+=(const Vector& v) {
+    for (size_t i = 0; i < 3; ++i) {
+        coords_[i] += v.coords_[i];
+    }
+    return *this;
+}
+
+inline Vector& Vector::operator-=(const Vector& v) {
+    for (size_t i = 0; i < 3; ++i) {
+        coords_[i] -= v.coords_[i];
+    }
+    return *this;
+}
+
+inline Vector& Vector::operator*=(const double value) {
+    for (double& coord: coords_) {
+        coord *= value;
+    }
+    return *this;
+}
+
+inline Vector& Vector::operator/=(const double value) {
+    return *this *= (1 / value);
+}
+
+inline Vector operator-(Vector v) {
+    return v *= -1;
+}
+
+inline Vector operator-(Vector v1, const Vector& v2) {
+    return v1 -= v2;
+}
+
+inline Vector operator+(Vector v1, const Vector& v2) {
+    return v1 += v2;
+}
+
+inline Vector operator*(const double d, Vector v) {
+    return v *= d;
+}
+
+inline Vector operator*(Vector v, const double d) {
+    return v *= d;
+}
+
+inline Vector operator/(Vector v, const double d) {
+    return v *= (1 / d);
+}
+
 }
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <string>
+
+#include "intersection_of_two_triangles/algorithms/are_nearly_equal.hpp"
+
+namespace intersection_of_two_triangles {
+
+struct GeneralTriangle;
+
+// Names the code path `are_intersecting(gt1, gt2, tolerance)` takes by the sub-objects the triangles are decomposed
+// into, e.g. "triangle / segment+point".
+[[nodiscard]] std::string code_path(const GeneralTriangle& gt1, const GeneralTriangle& gt2,
+                                    const Tolerance& = default_tolerance);
+
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace intersection_of_two_triangles {
+
+// A histogram of durations in nanoseconds in the style of HdrHistogram: values are grouped by the power of two they
+// are in, and each group is divided into 2^sub_bucket_bits equal buckets, so every recorded value is known with
+// the relative error below 2^-sub_bucket_bits, while the histogram takes a few kilobytes for any range of values.
+class LatencyHistogram {
+public:
+    static constexpr size_t sub_bucket_bits = 5;
+
+    LatencyHistogram();
+
+    void record(std::uint64_t nanoseconds);
+    void merge(const LatencyHistogram&);
+
+    [[nodiscard]] std::uint64_t count() const;
+    [[nodiscard]] std::uint64_t max() const;
+    // Returns the smallest value such that at least `percent` percents of the recorded values are not greater than it,
+    // up to the precision of the buckets. Returns 0 for an empty histogram.
+    [[nodiscard]] std::uint64_t percentile(double percent) const;
+
+private:
+    std::vector<std::uint64_t> counts_;
+    std::uint64_t count_ = 0;
+    std::uint64_t max_ = 0;
+};
+
+// Keeps the given number of the largest durations recorded together with the identifiers of their samples,
+// e.g. line numbers.
+class SlowestSamples {
+public:
+    explicit SlowestSamples(size_t capacity);
+
+    void record(std::uint64_t nanoseconds, size_t sample);
+
+    // Returns the kept (duration, sample) pairs, the slowest first.
+    [[nodiscard]] std::vector<std::pair<std::uint64_t, size_t>> sorted() const;
+
+private:
+    size_t capacity_;
+    // A min-heap, so the fastest of the kept samples is the first to be replaced.
+    std::vector<std::pair<std::uint64_t, size_t>> heap_;
+};
+
+}
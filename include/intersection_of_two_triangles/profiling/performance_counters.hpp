@@ -0,0 +1,67 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+
+namespace intersection_of_two_triangles {
+
+enum class Counter {
+    kCycles,
+    kInstructions,
+    kBranchMisses,
+    kCacheMisses,
+};
+
+inline constexpr size_t number_of_counters = 4;
+
+using CounterValues = std::array<std::uint64_t, number_of_counters>;
+
+// The hardware performance counters of the calling thread, counting in user space only. They are opened with
+// `perf_event_open` on Linux as a single group, so all of them are read with one system call. The counters which
+// can't be opened, e.g. in containers or virtual machines, are reported as unavailable and read as zeros.
+class PerformanceCounters {
+public:
+    PerformanceCounters();
+    ~PerformanceCounters();
+
+    PerformanceCounters(const PerformanceCounters&) = delete;
+    PerformanceCounters& operator=(const PerformanceCounters&) = delete;
+
+    [[nodiscard]] bool available() const;
+    [[nodiscard]] bool available(Counter) const;
+    // Describes why some of the counters are unavailable.
+    [[nodiscard]] const std::string& unavailability_reason() const;
+
+    [[nodiscard]] CounterValues read() const;
+
+private:
+    std::array<int, number_of_counters> descriptors_;
+    int leader_ = -1;
+    // The position of each counter in the group read, or `number_of_counters` when the counter isn't open.
+    std::array<size_t, number_of_counters> positions_;
+    size_t number_of_open_counters_ = 0;
+    std::string unavailability_reason_;
+};
+
+// Aggregates the counters read around pieces of work by the code paths they took.
+class PerformanceCountersReport {
+public:
+    void add(const std::string& path, const CounterValues& begin, const CounterValues& end);
+
+    // Prints the average counts per piece of work for every path and for all of them.
+    void print(std::ostream&, const PerformanceCounters&) const;
+
+private:
+    struct Totals {
+        size_t count = 0;
+        CounterValues values{};
+    };
+
+    std::map<std::string, Totals> paths_;
+};
+
+}
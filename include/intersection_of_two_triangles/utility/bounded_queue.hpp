@@ -0,0 +1,166 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+
+namespace intersection_of_two_triangles {
+
+// A bounded lock-free multi-producer multi-consumer queue (Dmitry Vyukov's algorithm): every cell has a sequence
+// number telling whether it's ready for the producer or the consumer of the current round, so the producers and the
+// consumers only contend on their own positions. The blocking `push` and `pop` wait while the queue is full or empty,
+// which gives backpressure between the stages of a pipeline: they retry for a short while and then sleep on a condition
+// variable, which the other side notifies only when somebody sleeps, so the fast path doesn't touch the mutex.
+template<class T>
+class BoundedQueue {
+public:
+    // The number of the retries of the blocking operations before they sleep.
+    static constexpr size_t spin_count = 64;
+
+    // The capacity is rounded up to a power of two.
+    explicit BoundedQueue(size_t capacity) {
+        size_t size = 1;
+        while (size < capacity) {
+            size *= 2;
+        }
+        cells_ = std::make_unique<Cell[]>(size);
+        for (size_t i = 0; i < size; ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        mask_ = size - 1;
+    }
+
+    // Returns false, leaving `value` intact, if the queue is full.
+    [[nodiscard]] bool try_push(T& value) {
+        size_t position = enqueue_position_.load(std::memory_order_relaxed);
+        for (; ; ) {
+            Cell& cell = cells_[position & mask_];
+            const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            if (sequence == position) {
+                if (enqueue_position_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    cell.value = std::move(value);
+                    cell.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (static_cast<std::ptrdiff_t>(sequence - position) < 0) {
+                return false;
+            } else {
+                position = enqueue_position_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Returns `std::nullopt` if the queue is empty.
+    [[nodiscard]] std::optional<T> try_pop() {
+        size_t position = dequeue_position_.load(std::memory_order_relaxed);
+        for (; ; ) {
+            Cell& cell = cells_[position & mask_];
+            const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            if (sequence == position + 1) {
+                if (dequeue_position_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    std::optional<T> result(std::move(cell.value));
+                    cell.sequence.store(position + mask_ + 1, std::memory_order_release);
+                    return result;
+                }
+            } else if (static_cast<std::ptrdiff_t>(sequence - (position + 1)) < 0) {
+                return std::nullopt;
+            } else {
+                position = dequeue_position_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void push(T value) {
+        for (size_t i = 0; i < spin_count; ++i) {
+            if (try_push(value)) {
+                notify(not_empty_, waiting_consumers_);
+                return;
+            }
+            std::this_thread::yield();
+        }
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            start_waiting(waiting_producers_);
+            not_full_.wait(lock, [&]() { return try_push(value); });
+            waiting_producers_.fetch_sub(1, std::memory_order_relaxed);
+        }
+        notify(not_empty_, waiting_consumers_);
+    }
+
+    // Waits for a value, returns `std::nullopt` when the queue is closed and empty.
+    [[nodiscard]] std::optional<T> pop() {
+        std::optional<T> result;
+        bool is_closed = false;
+        for (size_t i = 0; i < spin_count && !result && !is_closed; ++i) {
+            result = try_pop();
+            if (!result) {
+                is_closed = closed_.load(std::memory_order_acquire);
+                std::this_thread::yield();
+            }
+        }
+        if (!result && !is_closed) {
+            std::unique_lock<std::mutex> lock(mutex_);
+            start_waiting(waiting_consumers_);
+            not_empty_.wait(lock, [&]() {
+                result = try_pop();
+                return result || closed_.load(std::memory_order_acquire);
+            });
+            waiting_consumers_.fetch_sub(1, std::memory_order_relaxed);
+        }
+        if (!result) {
+            // The values pushed before closing are visible now.
+            result = try_pop();
+        }
+        if (result) {
+            notify(not_full_, waiting_producers_);
+        }
+        return result;
+    }
+
+    // Tells the consumers that nothing will be pushed anymore.
+    void close() {
+        closed_.store(true, std::memory_order_release);
+        const std::lock_guard<std::mutex> lock(mutex_);
+        not_empty_.notify_all();
+    }
+
+private:
+    // The fences order the counters of the sleeping threads against the sequence numbers of the cells: either a thread
+    // going to sleep sees the cell changed by the other side, or the other side sees the thread counted and notifies
+    // it under the mutex, which the thread holds until it sleeps.
+    void start_waiting(std::atomic<size_t>& waiting) {
+        waiting.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+
+    void notify(std::condition_variable& condition, const std::atomic<size_t>& waiting) {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiting.load(std::memory_order_relaxed) != 0) {
+            const std::lock_guard<std::mutex> lock(mutex_);
+            condition.notify_one();
+        }
+    }
+
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    std::unique_ptr<Cell[]> cells_;
+    size_t mask_{};
+    alignas(64) std::atomic<size_t> enqueue_position_{0};
+    alignas(64) std::atomic<size_t> dequeue_position_{0};
+    alignas(64) std::atomic<bool> closed_{false};
+    std::atomic<size_t> waiting_producers_{0};
+    std::atomic<size_t> waiting_consumers_{0};
+    std::mutex mutex_;
+    std::condition_variable not_full_;
+    std::condition_variable not_empty_;
+};
+
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+namespace intersection_of_two_triangles {
+
+// Disjoint sets of the indices [0, size) which can be united and queried from several threads without locks.
+// The root of a set is always its least index, since a root is only ever linked under a lesser root, so the roots
+// don't depend on the order of the unions. The paths are halved with compare-and-swap while searching.
+class ConcurrentDisjointSets {
+public:
+    explicit ConcurrentDisjointSets(size_t size);
+
+    [[nodiscard]] size_t size() const;
+    // Returns the least index of the set containing `x`.
+    [[nodiscard]] size_t find(size_t x);
+    [[nodiscard]] bool are_united(size_t a, size_t b);
+    void unite(size_t a, size_t b);
+
+private:
+    size_t size_;
+    std::unique_ptr<std::atomic<size_t>[]> parents_;
+};
+
+}
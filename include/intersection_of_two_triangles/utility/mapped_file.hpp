@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace intersection_of_two_triangles {
+
+// A file mapped into memory read-only, so its contents are parsed in place without copying.
+class MappedFile {
+public:
+    // Throws `Exception` if the file can't be opened or mapped.
+    explicit MappedFile(const std::string& path);
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    [[nodiscard]] std::string_view contents() const;
+
+private:
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+}
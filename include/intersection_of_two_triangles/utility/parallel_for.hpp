@@ -0,0 +1,55 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace intersection_of_two_triangles {
+
+// The number of threads the parallel algorithms use by default: the number of hardware threads, or 1 if it's unknown.
+[[nodiscard]] size_t default_number_of_threads();
+
+// Calls `body(thread, begin, end)` for chunks [begin, end) covering [0, size) on `threads` threads, where `thread`
+// is the index of the calling thread in [0, threads). The chunks of `chunk_size` indices are handed out dynamically,
+// so uneven work is balanced. The first exception thrown by `body` is rethrown after all the threads finish.
+template<class Body>
+void parallel_for(const size_t size, size_t threads, const size_t chunk_size, Body&& body) {
+    threads = std::max<size_t>(1, std::min(threads, (size + chunk_size - 1) / std::max<size_t>(1, chunk_size)));
+    std::atomic<size_t> next_chunk{0};
+    std::exception_ptr exception;
+    std::mutex exception_mutex;
+
+    const auto work = [&](const size_t thread) {
+        try {
+            for (size_t begin; (begin = next_chunk.fetch_add(chunk_size)) < size; ) {
+                body(thread, begin, std::min(size, begin + chunk_size));
+            }
+        } catch (...) {
+            const std::lock_guard lock(exception_mutex);
+            if (!exception) {
+                exception = std::current_exception();
+            }
+            next_chunk = size;
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    for (size_t thread = 1; thread < threads; ++thread) {
+        workers.emplace_back(work, thread);
+    }
+    work(0);
+    for (std::thread& worker: workers) {
+        worker.join();
+    }
+
+    if (exception) {
+        std::rethrow_exception(exception);
+    }
+}
+
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string>
+
+namespace intersection_of_two_triangles {
+
+// Forks `count` worker processes, calls `work(index)` in the worker with the given index and sends the returned
+// string to the parent over a pipe. Calls `consume(index, output)` with the outputs of the workers in the order of
+// their indices, each as soon as it is complete, so that the parent holds only one of them at a time; the workers
+// which finish early wait on their pipes until their turn. Throws `Exception` if a worker couldn't be started or
+// didn't finish successfully, including when `work` throws, after consuming the outputs of the workers before it.
+// The standard streams are flushed before forking, so that the workers don't repeat the buffered output.
+void run_in_worker_processes(size_t count, const std::function<std::string(size_t)>& work,
+                             const std::function<void(size_t, const std::string&)>& consume);
+
+}
@@ -1,14 +1,17 @@
 #include <algorithm>
 #include <array>
 #include <cassert>
+#include <cmath>
 #include <cstddef>
 #include <optional>
+#include <utility>
 #include <vector>
 
 #include "intersection_of_two_triangles/algorithms/are_nearly_equal.hpp"
 #include "intersection_of_two_triangles/algorithms/are_intersecting.hpp"
 #include "intersection_of_two_triangles/algorithms/determinant.hpp"
 #include "intersection_of_two_triangles/algorithms/dot_product.hpp"
+#include "intersection_of_two_triangles/primitives/box.hpp"
 #include "intersection_of_two_triangles/primitives/general_triangle.hpp"
 #include "intersection_of_two_triangles/primitives/line.hpp"
 #include "intersection_of_two_triangles/primitives/plane.hpp"
@@ -32,15 +35,15 @@ struct TrianglesTestResult {
     std::optional<size_t> lonely_vertex;
 };
 
-[[nodiscard]] TrianglesTestResult test_triangles(const Triangle& t1, const Triangle& t2) {
-    TrianglesTestResult result{Plane(t2.vertex(0), t2.vertex(1), t2.vertex(2))};
+[[nodiscard]] TrianglesTestResult test_triangles(const Triangle& t1, const Triangle& t2, const Tolerance& tolerance) {
+    TrianglesTestResult result{Plane(t2.vertex(0), t2.vertex(1), t2.vertex(2), tolerance)};
     auto& distances_to_p2 = result.signed_distances_to_triangle_plane;
     std::vector<size_t> positive;
     std::vector<size_t> negative;
 
     for (size_t i = 0; i < 3; ++i) {
-        distances_to_p2[i] = result.plane.signed_distance(t1.vertex(i));
-        if (!are_nearly_equal(distances_to_p2[i], 0)) {
+        distances_to_p2[i] = result.plane.signed_distance(t1.vertex(i), tolerance);
+        if (!is_nearly_zero(distances_to_p2[i], tolerance.of_degree(3))) {
             if (distances_to_p2[i] > 0) {
                 positive.push_back(i);
             } else {
@@ -73,20 +76,21 @@ struct TrianglesTestResult {
 
 // Projects p on the line ab. Returns the number t such that `t * (b - a)` is the projection.
 // Returns `std::nullopt` iff `a` and `b` are too close.
-[[nodiscard]] double project(const Point& p, const Point& a, const Point& b) {
-    assert(!are_nearly_equal(a, b));
+[[nodiscard]] double project(const Point& p, const Point& a, const Point& b, const Tolerance& tolerance) {
+    assert(!are_nearly_equal(a, b, tolerance));
     const Vector ab = b.radius_vector() - a.radius_vector();
-    const double ab2 = dot_product(ab, ab);
+    const double ab2 = dot_product(ab, ab, tolerance);
     assert(ab2 != 0);
     const Vector ap = p.radius_vector() - a.radius_vector();
-    const double ap_ab = dot_product(ap, ab);
+    const double ap_ab = dot_product(ap, ab, tolerance);
     return ap_ab / ab2;
 }
 
 // Returns the distance from p to the line through the points a and b.
-[[nodiscard]] double distance_from_point_to_segment(const Point& p, const Point& a, const Point& b) {
-    assert(!are_nearly_equal(a, b));
-    const double t = project(p, a, b);
+[[nodiscard]] double distance_from_point_to_segment(const Point& p, const Point& a, const Point& b,
+                                                    const Tolerance& tolerance) {
+    assert(!are_nearly_equal(a, b, tolerance));
+    const double t = project(p, a, b, tolerance);
 
     // Check if t is within the segment
     if (t < 0.0) { // Closest point is a
@@ -117,14 +121,17 @@ struct IntersectionResult {
     std::optional<std::array<double, 2>> st;
 };
 
-[[nodiscard]] IntersectionResult test_for_intersections(const Segment& s1, const Segment& s2) {
+// With `are_coplanar`, the caller knows that the segments lie in one plane, and the coordinate left out of the
+// projection isn't compared.
+[[nodiscard]] IntersectionResult test_for_intersections(const Segment& s1, const Segment& s2,
+                                                        const Tolerance& tolerance, const bool are_coplanar = false) {
     const Point& a = s1.endpoint(0);
     const Point& b = s1.endpoint(1);
     const Point& c = s2.endpoint(0);
     const Point& d = s2.endpoint(1);
 
-    assert(!are_nearly_equal(a, b));
-    assert(!are_nearly_equal(c, d));
+    assert(!are_nearly_equal(a, b, tolerance));
+    assert(!are_nearly_equal(c, d, tolerance));
 
     // s1: tA + (1-t)B
     // s2: sC + (1-s)D
@@ -137,51 +144,61 @@ struct IntersectionResult {
     const Vector w = d - b;
 
     // tu + sv = w
-
-    for (size_t coord0 = 0; coord0 < 2; ++coord0) {
-        for (size_t coord1 = coord0 + 1; coord1 < 3; ++coord1) {
-            const double vu_xy_det = determinant({v.coord(coord0), v.coord(coord1)},
-                                                 {u.coord(coord0), u.coord(coord1)});
-            if (vu_xy_det == 0 && coord0 + coord1 != 3) {
-                continue;
-            }
-            const double wu_xy_det = determinant({w.coord(coord0), w.coord(coord1)},
-                                                 {u.coord(coord0), u.coord(coord1)});
-            // +vu_xy_det * s = wu_xy_det
-            // -vu_xy_det * t = wv_xy_det
-            if (are_nearly_equal(0, vu_xy_det)) {
-                if (!are_nearly_equal(0, wu_xy_det) ||
-                    !are_nearly_equal(0, determinant({w.coord(coord0), w.coord(coord1)},
-                                                     {v.coord(coord0), v.coord(coord1)}))) {
-                    return {IntersectionStatus::kNotIntersected};
-                }
-                if (are_intersecting(a, s2) || are_intersecting(b, s2) || are_intersecting(c, s1)) {
-                    return {IntersectionStatus::kOverlapped};
-                }
-                return {IntersectionStatus::kNotIntersected};
-            }
-            const double s = wu_xy_det / vu_xy_det;
-            if (s < 0 || 1 < s) {
-                return {IntersectionStatus::kNotIntersected};
-            }
-            const double t =
-                -determinant({w.coord(coord0), w.coord(coord1)}, {v.coord(coord0), v.coord(coord1)}) / vu_xy_det;
-            const size_t coord2 = 3 - coord0 - coord1;
-            if (0 <= t && t <= 1 && are_nearly_equal(t * u.coord(coord2) + s * v.coord(coord2), w.coord(coord2))) {
-                return {IntersectionStatus::kIntersected, {{s, t}}};
-            }
+    //
+    // It is solved in the projection onto the coordinate plane where the directions span the largest area, since
+    // a nearly degenerate projection amplifies the rounding errors in the check of the remaining coordinate.
+
+    size_t coord0 = 1;
+    size_t coord1 = 2;
+    double vu_xy_det = 0;
+    for (const auto& [i, j]: {std::pair<size_t, size_t>{0, 1}, {0, 2}, {1, 2}}) {
+        const double det = determinant({v[i], v[j]}, {u[i], u[j]}, tolerance);
+        if (std::abs(det) >= std::abs(vu_xy_det)) {
+            coord0 = i;
+            coord1 = j;
+            vu_xy_det = det;
+        }
+    }
+    const double wu_xy_det = determinant({w[coord0], w[coord1]}, {u[coord0], u[coord1]}, tolerance);
+    // +vu_xy_det * s = wu_xy_det
+    // -vu_xy_det * t = wv_xy_det
+    if (is_nearly_zero(vu_xy_det, tolerance)) {
+        if (!is_nearly_zero(wu_xy_det, tolerance) ||
+            !is_nearly_zero(determinant({w[coord0], w[coord1]}, {v[coord0], v[coord1]}, tolerance), tolerance)) {
             return {IntersectionStatus::kNotIntersected};
         }
+        if (are_intersecting(a, s2, tolerance) ||
+            are_intersecting(b, s2, tolerance) ||
+            are_intersecting(c, s1, tolerance)) {
+            return {IntersectionStatus::kOverlapped};
+        }
+        return {IntersectionStatus::kNotIntersected};
+    }
+    const double s = wu_xy_det / vu_xy_det;
+    if (s < 0 || 1 < s) {
+        return {IntersectionStatus::kNotIntersected};
+    }
+    const double t = -determinant({w[coord0], w[coord1]}, {v[coord0], v[coord1]}, tolerance) / vu_xy_det;
+    // The points of the lines at t and s coincide in the coordinates of the projection. Their remaining coordinates
+    // are compared, rather than the terms of the difference, since those may nearly cancel while the rounding errors
+    // of s and t are relative to the coordinates of the points.
+    const size_t coord2 = 3 - coord0 - coord1;
+    if (0 <= t && t <= 1 &&
+        (are_coplanar ||
+         are_nearly_equal(b[coord2] + t * u[coord2], d[coord2] - s * v[coord2], tolerance.of_degree(1)))) {
+        return {IntersectionStatus::kIntersected, {{s, t}}};
     }
+    return {IntersectionStatus::kNotIntersected};
 }
 
-[[nodiscard]] bool triangle_contains_coplanar_point(const Triangle& t, const Point& p) {
-    const std::array<Segment, 2> basis{{{t.vertex(0), t.vertex(1)},
-                                        {t.vertex(0), t.vertex(2)}}};
+[[nodiscard]] bool triangle_contains_coplanar_point(const Triangle& t, const Point& p, const Tolerance& tolerance) {
+    const std::array<Segment, 2> basis{{{t.vertex(0), t.vertex(1), tolerance},
+                                        {t.vertex(0), t.vertex(2), tolerance}}};
     std::array<IntersectionResult, 2> test_results;
 
     for (const bool i: {0, 1}) {
-        test_results[i] = test_for_intersections(basis[i], {p, p - basis[!i].as_vector()});
+        test_results[i] = test_for_intersections(basis[i], {p, p - basis[!i].as_vector(), tolerance}, tolerance,
+                                                 true);
         if (test_results[i].intersection_status == IntersectionStatus::kNotIntersected) {
             return false;
         }
@@ -195,10 +212,15 @@ struct IntersectionResult {
 
 }
 
-bool are_intersecting(const GeneralTriangle& gt1, const GeneralTriangle& gt2) {
-    for (const auto& primitive1: gt1.as_non_degenerate()) {
-        for (const auto& primitive2: gt2.as_non_degenerate()) {
-            if (std::visit([](auto&& arg1, auto&& arg2) { return are_intersecting(arg1, arg2); },
+bool are_intersecting(const GeneralTriangle& gt1, const GeneralTriangle& gt2, const Tolerance& tolerance) {
+    return are_intersecting(gt1.as_non_degenerate(tolerance), gt2.as_non_degenerate(tolerance), tolerance);
+}
+
+bool are_intersecting(const GeneralTriangle::Decomposed& sub_objects1, const GeneralTriangle::Decomposed& sub_objects2,
+                      const Tolerance& tolerance) {
+    for (const auto& primitive1: sub_objects1) {
+        for (const auto& primitive2: sub_objects2) {
+            if (std::visit([&](auto&& arg1, auto&& arg2) { return are_intersecting(arg1, arg2, tolerance); },
                            primitive1, primitive2)) {
                 return true;
             }
@@ -208,70 +230,47 @@ bool are_intersecting(const GeneralTriangle& gt1, const GeneralTriangle& gt2) {
     return false;
 }
 
-bool are_intersecting(const Point& p1, const Point& p2) {
-    return are_nearly_equal(p1, p2);
+bool are_intersecting(const Point& p1, const Point& p2, const Tolerance& tolerance) {
+    return are_nearly_equal(p1, p2, tolerance);
 }
 
-bool are_intersecting(const Point& p, const Segment& s) {
-    return are_nearly_equal(0, distance_from_point_to_segment(p, s.endpoint(0), s.endpoint(1)));
+bool are_intersecting(const Point& p, const Segment& s, const Tolerance& tolerance) {
+    return is_nearly_zero(distance_from_point_to_segment(p, s.endpoint(0), s.endpoint(1), tolerance),
+                          tolerance.of_degree(1));
 }
 
-bool are_intersecting(const Point& p, const Triangle& t) {
-    const Plane plane(t.vertex(0), t.vertex(1), t.vertex(2));
-    return are_nearly_equal(0, plane.signed_distance(p)) && triangle_contains_coplanar_point(t, p);
+bool are_intersecting(const Point& p, const Triangle& t, const Tolerance& tolerance) {
+    return are_intersecting(p, t, Plane(t.vertex(0), t.vertex(1), t.vertex(2), tolerance), tolerance);
 }
 
-bool are_intersecting(const Segment& s, const Point& p) {
-    return are_intersecting(p, s);
+bool are_intersecting(const Segment& s, const Point& p, const Tolerance& tolerance) {
+    return are_intersecting(p, s, tolerance);
 }
 
-bool are_intersecting(const Segment& s1, const Segment& s2) {
-    return test_for_intersections(s1, s2).intersection_status != IntersectionStatus::kNotIntersected;
+bool are_intersecting(const Segment& s1, const Segment& s2, const Tolerance& tolerance) {
+    return test_for_intersections(s1, s2, tolerance).intersection_status != IntersectionStatus::kNotIntersected;
 }
 
-bool are_intersecting(const Segment& s, const Triangle& t) {
-    const Plane plane(t.vertex(0), t.vertex(1), t.vertex(2));
-    const Line line(s.endpoint(1) - s.endpoint(0), s.endpoint(0));
-
-    // u * direction + o = point and dot_product(normal, point) + d = 0 =>
-    // dot_product(normal, u * direction + o) + d = 0 =>
-    // u * dot_product(normal, direction) = -(d + dot_product(normal, o))
-
-    const double denominator = dot_product(plane.normal, line.direction);
-    const double normal_dot_o = dot_product(plane.normal, line.o.radius_vector());
-
-    if (are_nearly_equal(0, denominator)) {
-        if (!are_nearly_equal(-plane.d, normal_dot_o)) {
-            return false;
-        }
-        // s and t are coplanar
-        for (size_t i = 0; i < 3; ++i) {
-            if (are_intersecting(s, t.edge(i))) {
-                return true;
-            }
-        }
-        return are_intersecting(s.endpoint(0), t);
-    }
-
-    const double u = -(plane.d + normal_dot_o) / denominator;
-    return 0 <= u && u <= 1 && triangle_contains_coplanar_point(t, line.o + u * line.direction);
+bool are_intersecting(const Segment& s, const Triangle& t, const Tolerance& tolerance) {
+    return test_segment_against_triangle(s, t, Plane(t.vertex(0), t.vertex(1), t.vertex(2), tolerance), tolerance)
+        .intersecting;
 }
 
-bool are_intersecting(const Triangle& t, const Point& p) {
-    return are_intersecting(p, t);
+bool are_intersecting(const Triangle& t, const Point& p, const Tolerance& tolerance) {
+    return are_intersecting(p, t, tolerance);
 }
 
-bool are_intersecting(const Triangle& t, const Segment& s) {
-    return are_intersecting(s, t);
+bool are_intersecting(const Triangle& t, const Segment& s, const Tolerance& tolerance) {
+    return are_intersecting(s, t, tolerance);
 }
 
 // The algorithm is described here: https://fileadmin.cs.lth.se/cs/Personal/Tomas_Akenine-Moller/code/tritri_tam.pdf
-bool are_intersecting(const Triangle& t1, const Triangle& t2) {
+bool are_intersecting(const Triangle& t1, const Triangle& t2, const Tolerance& tolerance) {
     const std::array<const Triangle*, 2> ts{&t1, &t2};
     std::array<std::optional<TrianglesTestResult>, 2> triangles_tests_results;
 
     for (const bool i: {0, 1}) {
-        triangles_tests_results[i].emplace(test_triangles(*ts[i], *ts[!i]));
+        triangles_tests_results[i].emplace(test_triangles(*ts[i], *ts[!i], tolerance));
         if (triangles_tests_results[i]->all_vertices_are_on_the_same_side) {
             return false;
         }
@@ -279,25 +278,28 @@ bool are_intersecting(const Triangle& t1, const Triangle& t2) {
             // TODO: this part can be optimized.
             for (size_t edge_index_1 = 0; edge_index_1 < 3; ++edge_index_1) {
                 for (size_t edge_index_2 = 0; edge_index_2 < 3; ++edge_index_2) {
-                    if (are_intersecting(t1.edge(edge_index_1), t2.edge(edge_index_2))) {
+                    if (are_intersecting(t1.edge(edge_index_1, tolerance), t2.edge(edge_index_2, tolerance),
+                                         tolerance)) {
                         return true;
                     }
                 }
             }
-            return (are_intersecting(t1.vertex(0), t2) ||
-                    are_intersecting(t2.vertex(0), t1));
+            return (are_intersecting(t1.vertex(0), t2, tolerance) ||
+                    are_intersecting(t2.vertex(0), t1, tolerance));
         }
     }
 
     if (const auto planes_intersection = intersection(triangles_tests_results[0]->plane,
-                                                      triangles_tests_results[1]->plane)) {
+                                                      triangles_tests_results[1]->plane,
+                                                      tolerance)) {
         std::array<std::array<double, 2>, 2> us;
         for (const bool i: {0, 1}) {
             std::array<double, 3> projs;
             const size_t o = *triangles_tests_results[i]->lonely_vertex;
             for (size_t j = 0; j < 3; ++j) {
                 projs[j] = dot_product(planes_intersection->direction,
-                                       ts[i]->vertex((o + j) % 3) - planes_intersection->o);
+                                       ts[i]->vertex((o + j) % 3) - planes_intersection->o,
+                                       tolerance.of_degree(5));
             }
             const auto& signed_dists = triangles_tests_results[i]->signed_distances_to_triangle_plane;
             for (const bool j: {0, 1}) {
@@ -312,4 +314,101 @@ bool are_intersecting(const Triangle& t1, const Triangle& t2) {
     return false;
 }
 
+bool are_intersecting(const Point& p, const Triangle& t, const Plane& plane, const Tolerance& tolerance) {
+    return is_nearly_zero(plane.signed_distance(p, tolerance), tolerance.of_degree(3)) &&
+           triangle_contains_coplanar_point(t, p, tolerance);
+}
+
+SegmentTriangleTestResult test_segment_against_triangle(const Segment& s, const Triangle& t, const Plane& plane,
+                                                        const Tolerance& tolerance) {
+    const Line line(s.endpoint(1) - s.endpoint(0), s.endpoint(0));
+
+    // u * direction + o = point and dot_product(normal, point) + d = 0 =>
+    // dot_product(normal, u * direction + o) + d = 0 =>
+    // u * dot_product(normal, direction) = -(d + dot_product(normal, o))
+
+    const Tolerance cubic = tolerance.of_degree(3);
+    const double denominator = dot_product(plane.normal, line.direction, cubic);
+    const double normal_dot_o = dot_product(plane.normal, line.o.radius_vector(), cubic);
+
+    if (is_nearly_zero(denominator, cubic)) {
+        if (!are_nearly_equal(-plane.d, normal_dot_o, cubic)) {
+            return {false};
+        }
+        // s and t are coplanar
+        for (size_t i = 0; i < 3; ++i) {
+            if (are_intersecting(s, t.edge(i, tolerance), tolerance)) {
+                return {true};
+            }
+        }
+        return {are_intersecting(s.endpoint(0), t, plane, tolerance)};
+    }
+
+    const double u = -(plane.d + normal_dot_o) / denominator;
+    if (0 <= u && u <= 1 && triangle_contains_coplanar_point(t, line.o + u * line.direction, tolerance)) {
+        return {true, u};
+    }
+    return {false};
+}
+
+bool are_intersecting(const GeneralTriangle& gt, const Box& box, const Tolerance& tolerance) {
+    if (box.is_empty()) {
+        return false;
+    }
+    const Point center = box.center();
+    const std::array<double, 3> half_extents{box.extent(0) / 2, box.extent(1) / 2, box.extent(2) / 2};
+    const std::array<Vector, 3> v{gt.vertices[0] - center, gt.vertices[1] - center, gt.vertices[2] - center};
+    // Moving the vertices to the center rounds them relative to the magnitude of the coordinates rather than to that of
+    // the moved ones, which the relative epsilon of the comparisons below is applied to, so the projections are also
+    // compared with the relative epsilon of two coordinates of that magnitude, as `are_nearly_equal` compares them.
+    double magnitude = box.magnitude();
+    for (const Point& vertex: gt.vertices) {
+        magnitude = std::max({magnitude, std::abs(vertex.x()), std::abs(vertex.y()), std::abs(vertex.z())});
+    }
+    // The points which `are_intersecting` takes as equal are those whose squared distance is within the absolute
+    // epsilon, so the vertices this close to a face of the box along its normal may touch it.
+    const double point_distance = std::sqrt(tolerance.absolute_epsilon);
+
+    // The exact projections, since `dot_product` would round the small ones to zero. They are of one degree more than
+    // the axis.
+    const auto separates = [&](const Vector& axis, const int axis_degree, const double slack) {
+        const Tolerance projection_tolerance = tolerance.of_degree(axis_degree + 1);
+        std::array<double, 3> projections{};
+        for (size_t i = 0; i < 3; ++i) {
+            projections[i] = v[i][0] * axis[0] + v[i][1] * axis[1] + v[i][2] * axis[2];
+        }
+        const auto [min, max] = std::minmax({projections[0], projections[1], projections[2]});
+        const double radius = half_extents[0] * std::abs(axis[0]) + half_extents[1] * std::abs(axis[1]) +
+                              half_extents[2] * std::abs(axis[2]);
+        const double rounding =
+            2 * tolerance.relative_epsilon * magnitude * (std::abs(axis[0]) + std::abs(axis[1]) + std::abs(axis[2]));
+        const double gap = std::max(rounding, slack);
+        return (min - radius > gap && !are_nearly_equal(min, radius, projection_tolerance)) ||
+               (-radius - max > gap && !are_nearly_equal(max, -radius, projection_tolerance));
+    };
+
+    for (size_t i = 0; i < 3; ++i) {
+        Vector axis;
+        axis[i] = 1;
+        if (separates(axis, 0, point_distance)) {
+            return false;
+        }
+    }
+    const std::array<Vector, 3> edges{v[1] - v[0], v[2] - v[1], v[0] - v[2]};
+    const Vector normal(edges[0][1] * edges[1][2] - edges[0][2] * edges[1][1],
+                        edges[0][2] * edges[1][0] - edges[0][0] * edges[1][2],
+                        edges[0][0] * edges[1][1] - edges[0][1] * edges[1][0]);
+    if (separates(normal, 2, 0)) {
+        return false;
+    }
+    for (const Vector& edge: edges) {
+        // The cross products of the unit vectors of the axes with the edge.
+        if (separates({0, -edge[2], edge[1]}, 1, 0) || separates({edge[2], 0, -edge[0]}, 1, 0) ||
+            separates({-edge[1], edge[0], 0}, 1, 0)) {
+            return false;
+        }
+    }
+    return true;
+}
+
 }
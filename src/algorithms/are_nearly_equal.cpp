@@ -1,18 +1,40 @@
-#include <algorithm>
 #include <cmath>
-#include <limits>
 
 #include "intersection_of_two_triangles/algorithms/are_nearly_equal.hpp"
+#include "intersection_of_two_triangles/exception.hpp"
 
 namespace intersection_of_two_triangles {
 
-bool are_nearly_equal(const double a, const double b)
-{
-    static constexpr double absolute_epsilon = 1e-22;
-    static constexpr double relative_epsilon = std::numeric_limits<double>::epsilon() * 128;
-    const double diff = std::abs(a - b);
-    const double norm = std::min(std::abs(a) + std::abs(b), std::numeric_limits<double>::max());
-    return diff < std::max(absolute_epsilon, relative_epsilon * norm);
+Tolerance Tolerance::make(const double absolute_epsilon, const double relative_epsilon,
+                          const double coordinate_scale) {
+    for (const double value: {absolute_epsilon, relative_epsilon, coordinate_scale}) {
+        if (!(value > 0) || !std::isfinite(value)) {
+            throw Exception("Tolerance::make: the epsilons and the scale must be positive and finite");
+        }
+    }
+    if (relative_epsilon >= 1) {
+        throw Exception("Tolerance::make: the relative epsilon must be less than 1");
+    }
+    Tolerance result;
+    result.absolute_epsilon = absolute_epsilon;
+    result.relative_epsilon = relative_epsilon;
+    result.coordinate_scale = coordinate_scale;
+    for (int degree = 1; degree <= 5; ++degree) {
+        const double epsilon = absolute_epsilon * std::pow(coordinate_scale, degree - 2);
+        if (!(epsilon > 0) || !std::isfinite(epsilon)) {
+            throw Exception("Tolerance::make: the scale is out of range");
+        }
+        result.absolute_epsilons[degree - 1] = epsilon;
+    }
+    return result;
+}
+
+Tolerance Tolerance::for_scale(const double coordinate_scale) {
+    if (!(coordinate_scale > 0) || !std::isfinite(coordinate_scale)) {
+        throw Exception("Tolerance::for_scale: the scale must be positive and finite");
+    }
+    return make(default_tolerance.absolute_epsilon * coordinate_scale * coordinate_scale,
+                default_tolerance.relative_epsilon, coordinate_scale);
 }
 
 }
@@ -0,0 +1,99 @@
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+#include "intersection_of_two_triangles/algorithms/are_intersecting.hpp"
+#include "intersection_of_two_triangles/algorithms/batch_intersection.hpp"
+#include "intersection_of_two_triangles/primitives/segment.hpp"
+#include "intersection_of_two_triangles/primitives/triangle.hpp"
+
+namespace intersection_of_two_triangles {
+
+namespace {
+
+// A pair of sub-objects to check: the indices into the arrays of sub-objects of their kinds and the index of the
+// pair of triangles they come from.
+struct SubObjectPair {
+    size_t pair;
+    size_t first;
+    size_t second;
+};
+
+// The sub-objects of all the triangles, stored by kinds.
+struct SubObjects {
+    std::vector<Point> points;
+    std::vector<Segment> segments;
+    std::vector<Triangle> triangles;
+};
+
+// The kinds are ordered as in `GeneralTriangle::Decomposed`: a point, a segment, a triangle.
+[[nodiscard]] size_t bucket_index(const size_t kind1, const size_t kind2) {
+    return kind1 * 3 + kind2;
+}
+
+template<class T1, class T2>
+void check_bucket(const std::vector<SubObjectPair>& bucket, const std::vector<T1>& firsts,
+                  const std::vector<T2>& seconds, const Tolerance& tolerance, std::vector<bool>& result) {
+    for (const SubObjectPair& p: bucket) {
+        if (!result[p.pair] && are_intersecting(firsts[p.first], seconds[p.second], tolerance)) {
+            result[p.pair] = true;
+        }
+    }
+}
+
+}
+
+std::vector<bool> are_intersecting_batch(const std::vector<TrianglePair>& pairs, const Tolerance& tolerance) {
+    SubObjects sub_objects;
+    // The buckets of the pairs of kinds, indexed with `bucket_index`. The pairs of different kinds are put into
+    // the bucket with the lesser kind first, which is possible since the overloads are symmetric.
+    std::array<std::vector<SubObjectPair>, 9> buckets;
+    std::array<std::vector<std::pair<size_t, size_t>>, 2> decomposed;
+    // Most of the triangles aren't degenerate.
+    sub_objects.triangles.reserve(2 * pairs.size());
+    buckets[bucket_index(2, 2)].reserve(pairs.size());
+
+    for (size_t pair = 0; pair < pairs.size(); ++pair) {
+        for (size_t i = 0; i < 2; ++i) {
+            decomposed[i].clear();
+            for (auto& sub_object: pairs[pair][i].as_non_degenerate(tolerance)) {
+                const size_t index = std::visit([&](auto&& arg) {
+                    using T = std::decay_t<decltype(arg)>;
+                    if constexpr (std::is_same_v<T, Point>) {
+                        sub_objects.points.push_back(arg);
+                        return sub_objects.points.size() - 1;
+                    } else if constexpr (std::is_same_v<T, Segment>) {
+                        sub_objects.segments.push_back(arg);
+                        return sub_objects.segments.size() - 1;
+                    } else {
+                        sub_objects.triangles.push_back(arg);
+                        return sub_objects.triangles.size() - 1;
+                    }
+                }, sub_object);
+                decomposed[i].emplace_back(sub_object.index(), index);
+            }
+        }
+        for (const auto& [kind1, index1]: decomposed[0]) {
+            for (const auto& [kind2, index2]: decomposed[1]) {
+                if (kind1 <= kind2) {
+                    buckets[bucket_index(kind1, kind2)].push_back({pair, index1, index2});
+                } else {
+                    buckets[bucket_index(kind2, kind1)].push_back({pair, index2, index1});
+                }
+            }
+        }
+    }
+
+    std::vector<bool> result(pairs.size(), false);
+    const auto& [points, segments, triangles] = sub_objects;
+    check_bucket(buckets[bucket_index(0, 0)], points, points, tolerance, result);
+    check_bucket(buckets[bucket_index(0, 1)], points, segments, tolerance, result);
+    check_bucket(buckets[bucket_index(1, 1)], segments, segments, tolerance, result);
+    check_bucket(buckets[bucket_index(0, 2)], points, triangles, tolerance, result);
+    check_bucket(buckets[bucket_index(1, 2)], segments, triangles, tolerance, result);
+    check_bucket(buckets[bucket_index(2, 2)], triangles, triangles, tolerance, result);
+    return result;
+}
+
+}
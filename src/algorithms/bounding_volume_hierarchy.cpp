@@ -0,0 +1,88 @@
+#include <algorithm>
+#include <cassert>
+#include <numeric>
+
+#include "intersection_of_two_triangles/algorithms/bounding_volume_hierarchy.hpp"
+
+namespace intersection_of_two_triangles {
+
+bool BoundingVolumeHierarchy::Node::is_leaf() const {
+    return count != 0;
+}
+
+BoundingVolumeHierarchy::BoundingVolumeHierarchy(const std::vector<Box>& primitive_boxes) :
+    primitives_(primitive_boxes.size()) {
+    if (primitive_boxes.empty()) {
+        return;
+    }
+
+    std::iota(primitives_.begin(), primitives_.end(), size_t{0});
+    std::vector<Point> centers;
+    centers.reserve(primitive_boxes.size());
+    for (const Box& box: primitive_boxes) {
+        centers.push_back(box.center());
+    }
+    nodes_.reserve(2 * (primitive_boxes.size() / max_leaf_size + 1));
+    build(primitive_boxes, centers, 0, primitive_boxes.size());
+}
+
+void BoundingVolumeHierarchy::refit(const std::vector<Box>& primitive_boxes) {
+    assert(primitive_boxes.size() == primitives_.size());
+    // The children follow their parents, so they are refitted first.
+    for (size_t index = nodes_.size(); index-- > 0; ) {
+        Node& node = nodes_[index];
+        node.box = Box();
+        if (node.is_leaf()) {
+            for (size_t i = node.first; i < node.first + node.count; ++i) {
+                node.box.expand(primitive_boxes[primitives_[i]]);
+            }
+        } else {
+            node.box.expand(nodes_[index + 1].box);
+            node.box.expand(nodes_[node.first].box);
+        }
+    }
+}
+
+bool BoundingVolumeHierarchy::empty() const {
+    return nodes_.empty();
+}
+
+const std::vector<BoundingVolumeHierarchy::Node>& BoundingVolumeHierarchy::nodes() const {
+    return nodes_;
+}
+
+const std::vector<size_t>& BoundingVolumeHierarchy::primitives() const {
+    return primitives_;
+}
+
+// Builds the subtree over `primitives_[first] ... primitives_[last - 1]` by splitting it at the median of the box
+// centers along the longest axis of their bounds. Returns the index of the root of the subtree.
+size_t BoundingVolumeHierarchy::build(const std::vector<Box>& primitive_boxes, const std::vector<Point>& centers,
+                                      const size_t first, const size_t last) {
+    assert(first < last);
+    const size_t index = nodes_.size();
+    nodes_.push_back({Box(), first, last - first});
+
+    Box centers_bounds;
+    for (size_t i = first; i < last; ++i) {
+        nodes_[index].box.expand(primitive_boxes[primitives_[i]]);
+        centers_bounds.expand(centers[primitives_[i]]);
+    }
+
+    if (last - first <= max_leaf_size) {
+        return index;
+    }
+
+    const size_t axis = centers_bounds.longest_axis();
+    const size_t middle = first + (last - first) / 2;
+    std::nth_element(primitives_.begin() + first, primitives_.begin() + middle, primitives_.begin() + last,
+                     [&](const size_t a, const size_t b) { return centers[a][axis] < centers[b][axis]; });
+
+    build(primitive_boxes, centers, first, middle);
+    const size_t right = build(primitive_boxes, centers, middle, last);
+    nodes_[index].first = right;
+    nodes_[index].count = 0;
+    return index;
+}
+
+}
@@ -0,0 +1,220 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+#include "intersection_of_two_triangles/algorithms/cascade_intersection.hpp"
+
+namespace intersection_of_two_triangles {
+
+namespace {
+
+// The number of pairs filtered together.
+constexpr size_t lanes = 8;
+using Lanes = std::array<float, lanes>;
+
+constexpr float unit_roundoff = std::numeric_limits<float>::epsilon() / 2;
+// The error of an orientation is at most this times its permanent: the conversion of the coordinates to float and
+// the subtractions err by about 2 units of roundoff per factor, so 6 per product of three factors, and the evaluation
+// of the determinant by about 6 more. The bound is rounded up generously to cover the higher-order terms.
+constexpr float error_factor = 32 * unit_roundoff;
+// Covers the absolute errors of the products which underflow.
+constexpr float underflow_bound = 1e-36F;
+// The largest coordinate of a pair must be in this range, so that the products of three coordinates neither overflow
+// nor consist mostly of underflown terms. The other pairs are rechecked.
+constexpr double min_magnitude = 1e-9;
+constexpr double max_magnitude = 1e9;
+// The differences of the values which the double-precision path treats as equal are widened by this factor.
+constexpr double tolerance_factor = 64;
+
+// The six vertices of the pairs, the first triangle first, translated so that the first vertex of the first triangle
+// is at the origin: `coordinates[vertex][axis][lane]`.
+struct Block {
+    std::array<std::array<Lanes, 3>, 6> coordinates;
+    std::array<std::array<Lanes, 3>, 6> magnitudes;
+    // The absolute part of the bounds, infinite for the lanes which must be rechecked.
+    Lanes slack;
+};
+
+// The certified signs of a quantity for the lanes: 1 or -1, or 0 if the sign is uncertain.
+using Signs = Lanes;
+
+// Computes the signs of det(b - a, c - a, d - a) with a bound derived from the permanent, i.e. the determinant
+// of the magnitudes of the differences with all the terms added.
+[[nodiscard]] Signs orientation(const Block& block, const float relative_bound, const size_t a, const size_t b,
+                                const size_t c, const size_t d) {
+    const auto& p = block.coordinates;
+    const auto& m = block.magnitudes;
+    Signs result;
+    for (size_t lane = 0; lane < lanes; ++lane) {
+        const float ux = p[b][0][lane] - p[a][0][lane];
+        const float uy = p[b][1][lane] - p[a][1][lane];
+        const float uz = p[b][2][lane] - p[a][2][lane];
+        const float vx = p[c][0][lane] - p[a][0][lane];
+        const float vy = p[c][1][lane] - p[a][1][lane];
+        const float vz = p[c][2][lane] - p[a][2][lane];
+        const float wx = p[d][0][lane] - p[a][0][lane];
+        const float wy = p[d][1][lane] - p[a][1][lane];
+        const float wz = p[d][2][lane] - p[a][2][lane];
+        const float value = ux * (vy * wz - vz * wy) - uy * (vx * wz - vz * wx) + uz * (vx * wy - vy * wx);
+
+        // The magnitudes of the coordinates bound the differences together with the errors of their conversion.
+        const float mux = m[b][0][lane] + m[a][0][lane];
+        const float muy = m[b][1][lane] + m[a][1][lane];
+        const float muz = m[b][2][lane] + m[a][2][lane];
+        const float mvx = m[c][0][lane] + m[a][0][lane];
+        const float mvy = m[c][1][lane] + m[a][1][lane];
+        const float mvz = m[c][2][lane] + m[a][2][lane];
+        const float mwx = m[d][0][lane] + m[a][0][lane];
+        const float mwy = m[d][1][lane] + m[a][1][lane];
+        const float mwz = m[d][2][lane] + m[a][2][lane];
+        const float permanent =
+            mux * (mvy * mwz + mvz * mwy) + muy * (mvx * mwz + mvz * mwx) + muz * (mvx * mwy + mvy * mwx);
+
+        const float bound = permanent * relative_bound + block.slack[lane];
+        result[lane] = static_cast<float>(value > bound) - static_cast<float>(value < -bound);
+    }
+    return result;
+}
+
+enum class Verdict {
+    disjoint,
+    intersecting,
+    uncertain,
+};
+
+// Whether the edge of one triangle whose endpoints have the signs `side1` and `side2` relative to the plane of
+// the other triangle crosses it, given the signs of the orientations of the edge with the edges of that triangle.
+[[nodiscard]] Verdict crossing(const float side1, const float side2, const std::array<float, 3>& edges) {
+    if (side1 == side2) {
+        return Verdict::disjoint;
+    }
+    const bool positive = std::find(edges.begin(), edges.end(), 1.0F) != edges.end();
+    const bool negative = std::find(edges.begin(), edges.end(), -1.0F) != edges.end();
+    if (positive && negative) {
+        return Verdict::disjoint;
+    }
+    // The line of the edge passes through the interior of the triangle iff all the orientations have the same sign.
+    if (std::find(edges.begin(), edges.end(), 0.0F) == edges.end()) {
+        return Verdict::intersecting;
+    }
+    return Verdict::uncertain;
+}
+
+// Triangles which aren't coplanar and don't touch intersect iff an edge of one of them crosses the other one.
+[[nodiscard]] Verdict classify(const std::array<Signs, 3>& first_sides, const std::array<Signs, 3>& second_sides,
+                               const std::array<std::array<Signs, 3>, 3>& edges, const size_t lane) {
+    // `first_sides[i]` is the side of the vertex i of the first triangle relative to the plane of the second one.
+    for (const auto* const sides: {&first_sides, &second_sides}) {
+        const float side = (*sides)[0][lane];
+        if (side != 0 && (*sides)[1][lane] == side && (*sides)[2][lane] == side) {
+            return Verdict::disjoint;
+        }
+    }
+    for (size_t i = 0; i < 3; ++i) {
+        if (first_sides[i][lane] == 0 || second_sides[i][lane] == 0) {
+            return Verdict::uncertain;
+        }
+    }
+
+    bool is_uncertain = false;
+    for (size_t i = 0; i < 3; ++i) {
+        // The edge i of the first triangle with all the edges of the second one, and the other way around.
+        const std::array<float, 3> of_first{edges[i][0][lane], edges[i][1][lane], edges[i][2][lane]};
+        const std::array<float, 3> of_second{edges[0][i][lane], edges[1][i][lane], edges[2][i][lane]};
+        for (const Verdict verdict: {crossing(first_sides[i][lane], first_sides[(i + 1) % 3][lane], of_first),
+                                     crossing(second_sides[i][lane], second_sides[(i + 1) % 3][lane], of_second)}) {
+            if (verdict == Verdict::intersecting) {
+                return verdict;
+            }
+            is_uncertain |= verdict == Verdict::uncertain;
+        }
+    }
+    return is_uncertain ? Verdict::uncertain : Verdict::disjoint;
+}
+
+void fill(Block& block, const TrianglePair* const pairs, const size_t count, const Tolerance& tolerance) {
+    const double cubic_epsilon = tolerance.of_degree(3).absolute_epsilon;
+    for (size_t lane = 0; lane < lanes; ++lane) {
+        if (lane >= count) {
+            block.slack[lane] = std::numeric_limits<float>::infinity();
+            continue;
+        }
+        const Point& origin = pairs[lane][0].vertices[0];
+        double magnitude = 0;
+        for (size_t vertex = 0; vertex < 6; ++vertex) {
+            const Point& p = pairs[lane][vertex / 3].vertices[vertex % 3];
+            for (size_t axis = 0; axis < 3; ++axis) {
+                const double coordinate = p[axis] - origin[axis];
+                block.coordinates[vertex][axis][lane] = static_cast<float>(coordinate);
+                block.magnitudes[vertex][axis][lane] = std::abs(static_cast<float>(coordinate));
+                magnitude = std::max(magnitude, std::abs(coordinate));
+            }
+        }
+        // The orientations are products of three coordinates.
+        const bool is_in_range = min_magnitude <= magnitude && magnitude <= max_magnitude;
+        block.slack[lane] = is_in_range ? static_cast<float>(tolerance_factor * cubic_epsilon + underflow_bound)
+                                        : std::numeric_limits<float>::infinity();
+    }
+}
+
+}
+
+std::vector<bool> are_intersecting_cascade(const std::vector<TrianglePair>& pairs, const Tolerance& tolerance,
+                                           CascadeStatistics* const statistics) {
+    const auto relative_bound =
+        static_cast<float>(error_factor + tolerance_factor * tolerance.relative_epsilon);
+    std::vector<bool> result(pairs.size());
+    std::vector<size_t> uncertain;
+    CascadeStatistics counts;
+
+    Block block{};
+    for (size_t first = 0; first < pairs.size(); first += lanes) {
+        const size_t count = std::min(lanes, pairs.size() - first);
+        fill(block, pairs.data() + first, count, tolerance);
+
+        std::array<Signs, 3> first_sides;
+        std::array<Signs, 3> second_sides;
+        std::array<std::array<Signs, 3>, 3> edges;
+        for (size_t i = 0; i < 3; ++i) {
+            first_sides[i] = orientation(block, relative_bound, 3, 4, 5, i);
+            second_sides[i] = orientation(block, relative_bound, 0, 1, 2, 3 + i);
+            for (size_t j = 0; j < 3; ++j) {
+                edges[i][j] = orientation(block, relative_bound, i, (i + 1) % 3, 3 + j, 3 + (j + 1) % 3);
+            }
+        }
+
+        for (size_t lane = 0; lane < count; ++lane) {
+            switch (classify(first_sides, second_sides, edges, lane)) {
+                case Verdict::disjoint:
+                    ++counts.certified_disjoint;
+                    break;
+                case Verdict::intersecting:
+                    result[first + lane] = true;
+                    ++counts.certified_intersecting;
+                    break;
+                case Verdict::uncertain:
+                    uncertain.push_back(first + lane);
+                    break;
+            }
+        }
+    }
+
+    std::vector<TrianglePair> rechecked;
+    rechecked.reserve(uncertain.size());
+    for (const size_t index: uncertain) {
+        rechecked.push_back(pairs[index]);
+    }
+    const std::vector<bool> answers = are_intersecting_batch(rechecked, tolerance);
+    for (size_t i = 0; i < uncertain.size(); ++i) {
+        result[uncertain[i]] = answers[i];
+    }
+    counts.rechecked = uncertain.size();
+    if (statistics) {
+        *statistics = counts;
+    }
+    return result;
+}
+
+}
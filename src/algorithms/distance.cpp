@@ -0,0 +1,309 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "intersection_of_two_triangles/algorithms/are_intersecting.hpp"
+#include "intersection_of_two_triangles/algorithms/distance.hpp"
+#include "intersection_of_two_triangles/primitives/box.hpp"
+#include "intersection_of_two_triangles/primitives/vector.hpp"
+
+namespace intersection_of_two_triangles {
+
+namespace {
+
+// Unlike `dot_product` and `cross_product`, these don't round small results to zero, which would distort
+// the distances between close features.
+[[nodiscard]] double dot(const Vector& v1, const Vector& v2) {
+    return v1.x() * v2.x() + v1.y() * v2.y() + v1.z() * v2.z();
+}
+
+[[nodiscard]] Vector cross(const Vector& v1, const Vector& v2) {
+    return {v1.y() * v2.z() - v1.z() * v2.y(), v1.z() * v2.x() - v1.x() * v2.z(), v1.x() * v2.y() - v1.y() * v2.x()};
+}
+
+[[nodiscard]] ClosestPoints make_closest_points(const Point& first, const Point& second) {
+    return {first, second, distance(first, second)};
+}
+
+// Returns the closest point of the segment [a, b] to p.
+[[nodiscard]] Point closest_point_on_segment(const Point& p, const Point& a, const Point& b) {
+    const Vector ab = b - a;
+    const double ab2 = dot(ab, ab);
+    if (ab2 == 0) {
+        return a;
+    }
+    return a + std::clamp(dot(p - a, ab) / ab2, 0.0, 1.0) * ab;
+}
+
+// Returns the closest point of the triangle to p, finding the Voronoi region of p as in Christer Ericson,
+// "Real-Time Collision Detection", 5.1.5.
+[[nodiscard]] Point closest_point_on_triangle(const Point& p, const std::array<Point, 3>& t) {
+    const Point& a = t[0];
+    const Point& b = t[1];
+    const Point& c = t[2];
+    const Vector ab = b - a;
+    const Vector ac = c - a;
+
+    const Vector ap = p - a;
+    const double d1 = dot(ab, ap);
+    const double d2 = dot(ac, ap);
+    if (d1 <= 0 && d2 <= 0) {
+        return a;
+    }
+    const Vector bp = p - b;
+    const double d3 = dot(ab, bp);
+    const double d4 = dot(ac, bp);
+    if (d3 >= 0 && d4 <= d3) {
+        return b;
+    }
+    const double vc = d1 * d4 - d3 * d2;
+    if (vc <= 0 && d1 >= 0 && d3 <= 0) {
+        return a + d1 / (d1 - d3) * ab;
+    }
+    const Vector cp = p - c;
+    const double d5 = dot(ab, cp);
+    const double d6 = dot(ac, cp);
+    if (d6 >= 0 && d5 <= d6) {
+        return c;
+    }
+    const double vb = d5 * d2 - d1 * d6;
+    if (vb <= 0 && d2 >= 0 && d6 <= 0) {
+        return a + d2 / (d2 - d6) * ac;
+    }
+    const double va = d3 * d6 - d5 * d4;
+    if (va <= 0 && d4 - d3 >= 0 && d5 - d6 >= 0) {
+        return b + (d4 - d3) / ((d4 - d3) + (d5 - d6)) * (c - b);
+    }
+    const double area = va + vb + vc;
+    if (!(area > 0)) {
+        // The triangle is degenerate, so its closest point lies on one of its sides.
+        std::array<Point, 3> candidates{closest_point_on_segment(p, a, b), closest_point_on_segment(p, b, c),
+                                        closest_point_on_segment(p, c, a)};
+        return *std::min_element(candidates.begin(), candidates.end(), [&](const Point& q1, const Point& q2) {
+            return distance(p, q1) < distance(p, q2);
+        });
+    }
+    return a + vb / area * ab + vc / area * ac;
+}
+
+// Returns the closest points of the segments [p1, q1] and [p2, q2] as in Christer Ericson, "Real-Time Collision
+// Detection", 5.1.9.
+[[nodiscard]] ClosestPoints closest_points_of_segments(const Point& p1, const Point& q1, const Point& p2,
+                                                       const Point& q2) {
+    const Vector d1 = q1 - p1;
+    const Vector d2 = q2 - p2;
+    const Vector r = p1 - p2;
+    const double a = dot(d1, d1);
+    const double e = dot(d2, d2);
+    const double f = dot(d2, r);
+
+    if (a == 0 && e == 0) {
+        return make_closest_points(p1, p2);
+    }
+    double s = 0;
+    double t = 0;
+    if (a == 0) {
+        t = std::clamp(f / e, 0.0, 1.0);
+    } else {
+        const double c = dot(d1, r);
+        if (e == 0) {
+            s = std::clamp(-c / a, 0.0, 1.0);
+        } else {
+            const double b = dot(d1, d2);
+            const double denominator = a * e - b * b;
+            // For parallel segments any s works, and 0 is taken.
+            s = denominator > 0 ? std::clamp((b * f - c * e) / denominator, 0.0, 1.0) : 0;
+            t = (b * s + f) / e;
+            if (t < 0) {
+                t = 0;
+                s = std::clamp(-c / a, 0.0, 1.0);
+            } else if (t > 1) {
+                t = 1;
+                s = std::clamp((b - c) / a, 0.0, 1.0);
+            }
+        }
+    }
+    return make_closest_points(p1 + s * d1, p2 + t * d2);
+}
+
+void update(ClosestPoints& best, const ClosestPoints& candidate) {
+    if (candidate.distance < best.distance) {
+        best = candidate;
+    }
+}
+
+// Updates `best` with the points where the edges of `t1` cross the plane of `t2`. Such a point is in `t2` if
+// the triangles intersect and aren't coplanar.
+void check_edges_crossing_plane(const std::array<Point, 3>& t1, const std::array<Point, 3>& t2, const bool swapped,
+                                ClosestPoints& best) {
+    const Vector normal = cross(t2[1] - t2[0], t2[2] - t2[0]);
+    if (dot(normal, normal) == 0) {
+        return;
+    }
+    for (size_t i = 0; i < 3; ++i) {
+        const Point& p = t1[i];
+        const Point& q = t1[(i + 1) % 3];
+        const double dp = dot(normal, p - t2[0]);
+        const double dq = dot(normal, q - t2[0]);
+        if (!((dp < 0 && dq > 0) || (dp > 0 && dq < 0))) {
+            continue;
+        }
+        const Point crossing = p + dp / (dp - dq) * (q - p);
+        const Point closest = closest_point_on_triangle(crossing, t2);
+        update(best, swapped ? make_closest_points(closest, crossing) : make_closest_points(crossing, closest));
+    }
+}
+
+}
+
+ClosestPoints closest_points(const GeneralTriangle& gt1, const GeneralTriangle& gt2) {
+    const auto& t1 = gt1.vertices;
+    const auto& t2 = gt2.vertices;
+    ClosestPoints best{t1[0], t2[0], std::numeric_limits<double>::infinity()};
+    for (size_t i = 0; i < 3; ++i) {
+        update(best, make_closest_points(t1[i], closest_point_on_triangle(t1[i], t2)));
+        update(best, make_closest_points(closest_point_on_triangle(t2[i], t1), t2[i]));
+        for (size_t j = 0; j < 3; ++j) {
+            update(best, closest_points_of_segments(t1[i], t1[(i + 1) % 3], t2[j], t2[(j + 1) % 3]));
+        }
+    }
+    check_edges_crossing_plane(t1, t2, false, best);
+    check_edges_crossing_plane(t2, t1, true, best);
+    return best;
+}
+
+double distance(const GeneralTriangle& gt1, const GeneralTriangle& gt2) {
+    return closest_points(gt1, gt2).distance;
+}
+
+bool are_within_distance(const GeneralTriangle& gt1, const GeneralTriangle& gt2, const double d,
+                         const Tolerance& tolerance) {
+    const Tolerance linear = tolerance.of_degree(1);
+    const double box_distance =
+        distance(conservative_bounding_box(gt1, tolerance), conservative_bounding_box(gt2, tolerance));
+    if (box_distance > d && !are_nearly_equal(box_distance, d, linear)) {
+        return false;
+    }
+    // The distance 0 means intersecting, which is decided by `are_intersecting` with its own epsilons, so that the two
+    // agree: the plain distance of the triangles which it takes as touching may be slightly positive, and vice versa.
+    if (are_intersecting(gt1, gt2, tolerance)) {
+        return true;
+    }
+    if (!(d > 0)) {
+        return false;
+    }
+    const double triangle_distance = distance(gt1, gt2);
+    return triangle_distance <= d || are_nearly_equal(triangle_distance, d, linear);
+}
+
+namespace {
+
+struct NodePair {
+    size_t first;
+    size_t second;
+    double distance;
+};
+
+// Pushes the pairs of the children of the node with the larger box, or of the one which isn't a leaf, with the other
+// node, the nearer pair last, so that it's visited first.
+void push_children(const MeshIndex& mesh1, const MeshIndex& mesh2, const NodePair& pair,
+                   std::vector<NodePair>& stack) {
+    const auto& nodes1 = mesh1.hierarchy().nodes();
+    const auto& nodes2 = mesh2.hierarchy().nodes();
+    const auto& node1 = nodes1[pair.first];
+    const auto& node2 = nodes2[pair.second];
+    const auto size = [](const Box& box) {
+        return box.extent(0) + box.extent(1) + box.extent(2);
+    };
+    const bool split_first = node2.is_leaf() || (!node1.is_leaf() && size(node1.box) >= size(node2.box));
+
+    std::array<NodePair, 2> children{};
+    if (split_first) {
+        for (const auto& [i, child]: {std::pair(0, pair.first + 1), std::pair(1, node1.first)}) {
+            children[i] = {child, pair.second, distance(nodes1[child].box, node2.box)};
+        }
+    } else {
+        for (const auto& [i, child]: {std::pair(0, pair.second + 1), std::pair(1, node2.first)}) {
+            children[i] = {pair.first, child, distance(node1.box, nodes2[child].box)};
+        }
+    }
+    if (children[0].distance < children[1].distance) {
+        std::swap(children[0], children[1]);
+    }
+    stack.insert(stack.end(), children.begin(), children.end());
+}
+
+// Visits the pairs of leaves of the hierarchies whose boxes are at most `bound()` apart, nearest first, calling
+// `visit(a, b)` for the pairs of their triangles until it returns true.
+template<class Bound, class Visit>
+void traverse(const MeshIndex& mesh1, const MeshIndex& mesh2, Bound&& bound, Visit&& visit) {
+    if (mesh1.hierarchy().empty() || mesh2.hierarchy().empty()) {
+        return;
+    }
+    const auto& nodes1 = mesh1.hierarchy().nodes();
+    const auto& nodes2 = mesh2.hierarchy().nodes();
+    const auto& primitives1 = mesh1.hierarchy().primitives();
+    const auto& primitives2 = mesh2.hierarchy().primitives();
+
+    std::vector<NodePair> stack{{0, 0, distance(nodes1[0].box, nodes2[0].box)}};
+    while (!stack.empty()) {
+        const NodePair pair = stack.back();
+        stack.pop_back();
+        if (!bound(pair.distance)) {
+            continue;
+        }
+        const auto& node1 = nodes1[pair.first];
+        const auto& node2 = nodes2[pair.second];
+        if (!node1.is_leaf() || !node2.is_leaf()) {
+            push_children(mesh1, mesh2, pair, stack);
+            continue;
+        }
+        for (size_t i = node1.first; i < node1.first + node1.count; ++i) {
+            for (size_t j = node2.first; j < node2.first + node2.count; ++j) {
+                const size_t a = primitives1[i];
+                const size_t b = primitives2[j];
+                if (bound(distance(mesh1.triangle_box(a), mesh2.triangle_box(b))) && visit(a, b)) {
+                    return;
+                }
+            }
+        }
+    }
+}
+
+}
+
+std::optional<MeshClosestPoints> closest_points(const MeshIndex& mesh1, const MeshIndex& mesh2) {
+    std::optional<MeshClosestPoints> result;
+    const auto bound = [&](const double box_distance) {
+        return !result || box_distance < result->points.distance;
+    };
+    traverse(mesh1, mesh2, bound, [&](const size_t a, const size_t b) {
+        const ClosestPoints points = closest_points(mesh1.triangles()[a], mesh2.triangles()[b]);
+        if (!result || points.distance < result->points.distance) {
+            result = MeshClosestPoints{a, b, points};
+        }
+        return result->points.distance == 0;
+    });
+    return result;
+}
+
+std::optional<std::pair<size_t, size_t>> find_pair_within_distance(const MeshIndex& mesh1, const MeshIndex& mesh2,
+                                                                   const double d) {
+    const Tolerance& tolerance = mesh1.tolerance();
+    const Tolerance linear = tolerance.of_degree(1);
+    std::optional<std::pair<size_t, size_t>> result;
+    const auto bound = [&](const double box_distance) {
+        return box_distance <= d || are_nearly_equal(box_distance, d, linear);
+    };
+    traverse(mesh1, mesh2, bound, [&](const size_t a, const size_t b) {
+        if (are_within_distance(mesh1.triangles()[a], mesh2.triangles()[b], d, tolerance)) {
+            result.emplace(a, b);
+        }
+        return result.has_value();
+    });
+    return result;
+}
+
+}
@@ -4,14 +4,14 @@
 
 namespace intersection_of_two_triangles {
 
-double dot_product(const Vector& v1, const Vector& v2) {
-    const double x = v1.x * v2.x;
-    const double y = v1.y * v2.y;
-    const double z = v1.z * v2.z;
+double dot_product(const Vector& v1, const Vector& v2, const Tolerance& tolerance) {
+    const double x = v1.x() * v2.x();
+    const double y = v1.y() * v2.y();
+    const double z = v1.z() * v2.z();
 
-    if (are_nearly_equal(-x, y + z) ||
-        are_nearly_equal(-y, z + x) ||
-        are_nearly_equal(-z, x + y)) {
+    if (are_nearly_equal(-x, y + z, tolerance) ||
+        are_nearly_equal(-y, z + x, tolerance) ||
+        are_nearly_equal(-z, x + y, tolerance)) {
         return 0;
     }
 
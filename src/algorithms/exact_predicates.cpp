@@ -0,0 +1,227 @@
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <variant>
+
+#include "intersection_of_two_triangles/algorithms/exact_predicates.hpp"
+
+namespace intersection_of_two_triangles {
+
+namespace {
+
+// With coordinates bounded by 2^40, the differences are bounded by 2^41, the components of cross products by 2^83
+// and the determinants by 2^126, so all of them fit into a signed 128-bit integer.
+static_assert(Quantizer::max_coordinate <= (std::int64_t{1} << 40));
+
+using Wide = __int128;
+
+struct WideVector {
+    [[nodiscard]] bool is_zero() const {
+        return x == 0 && y == 0 && z == 0;
+    }
+
+    Wide x, y, z;
+};
+
+[[nodiscard]] WideVector operator-(const LatticePoint& a, const LatticePoint& b) {
+    return {Wide{a.x} - b.x, Wide{a.y} - b.y, Wide{a.z} - b.z};
+}
+
+[[nodiscard]] WideVector cross_product(const WideVector& u, const WideVector& v) {
+    return {u.y * v.z - u.z * v.y,
+            u.z * v.x - u.x * v.z,
+            u.x * v.y - u.y * v.x};
+}
+
+[[nodiscard]] Wide dot_product(const WideVector& u, const WideVector& v) {
+    return u.x * v.x + u.y * v.y + u.z * v.z;
+}
+
+[[nodiscard]] int sign(const Wide value) {
+    return (value > 0) - (value < 0);
+}
+
+[[nodiscard]] Wide abs(const Wide value) {
+    return value < 0 ? -value : value;
+}
+
+// The coordinate along which a plane with the given normal is projected onto a coordinate plane without losing
+// orientations: the one of the largest normal component.
+[[nodiscard]] size_t dropped_axis(const WideVector& normal) {
+    assert(!normal.is_zero());
+    if (abs(normal.x) >= abs(normal.y) && abs(normal.x) >= abs(normal.z)) {
+        return 0;
+    }
+    return abs(normal.y) >= abs(normal.z) ? 1 : 2;
+}
+
+// The orientation of the projections of coplanar points onto the coordinate plane orthogonal to `axis`.
+[[nodiscard]] int orientation_2d(const LatticePoint& a, const LatticePoint& b, const LatticePoint& c,
+                                 const size_t axis) {
+    const WideVector ab = b - a;
+    const WideVector ac = c - a;
+    switch (axis) {
+        case 0:
+            return sign(ab.y * ac.z - ab.z * ac.y);
+        case 1:
+            return sign(ab.z * ac.x - ab.x * ac.z);
+        default:
+            return sign(ab.x * ac.y - ab.y * ac.x);
+    }
+}
+
+struct LatticeSegment {
+    std::array<LatticePoint, 2> endpoints;
+};
+
+using LatticeTriangle = QuantizedTriangle;
+
+using SubObject = std::variant<LatticePoint, LatticeSegment, LatticeTriangle>;
+
+// Collinear triangles become the segment between their farthest vertices and triangles with all the vertices equal
+// become points.
+[[nodiscard]] SubObject as_non_degenerate(const QuantizedTriangle& t) {
+    const auto& [a, b, c] = t.vertices;
+    if (!cross_product(b - a, c - a).is_zero()) {
+        return t;
+    }
+    std::array<Wide, 3> squared_lengths;
+    for (size_t i = 0; i < 3; ++i) {
+        const WideVector side = t.vertices[(i + 1) % 3] - t.vertices[(i + 2) % 3];
+        squared_lengths[i] = dot_product(side, side);
+    }
+    size_t longest = 0;
+    for (size_t i = 1; i < 3; ++i) {
+        if (squared_lengths[i] > squared_lengths[longest]) {
+            longest = i;
+        }
+    }
+    if (squared_lengths[longest] == 0) {
+        return a;
+    }
+    return LatticeSegment{{t.vertices[(longest + 1) % 3], t.vertices[(longest + 2) % 3]}};
+}
+
+[[nodiscard]] bool intersect(const LatticePoint& p1, const LatticePoint& p2) {
+    return p1 == p2;
+}
+
+[[nodiscard]] bool intersect(const LatticePoint& p, const LatticeSegment& s) {
+    const auto& [a, b] = s.endpoints;
+    const WideVector ab = b - a;
+    const WideVector ap = p - a;
+    return cross_product(ab, ap).is_zero() && dot_product(ap, ab) >= 0 && dot_product(p - b, a - b) >= 0;
+}
+
+[[nodiscard]] bool intersect(const LatticePoint& p, const LatticeTriangle& t) {
+    const auto& [a, b, c] = t.vertices;
+    if (orientation(a, b, c, p) != 0) {
+        return false;
+    }
+    const size_t axis = dropped_axis(cross_product(b - a, c - a));
+    const int o1 = orientation_2d(a, b, p, axis);
+    const int o2 = orientation_2d(b, c, p, axis);
+    const int o3 = orientation_2d(c, a, p, axis);
+    return (o1 >= 0 && o2 >= 0 && o3 >= 0) || (o1 <= 0 && o2 <= 0 && o3 <= 0);
+}
+
+[[nodiscard]] bool intersect(const LatticeSegment& s1, const LatticeSegment& s2) {
+    const auto& [a, b] = s1.endpoints;
+    const auto& [c, d] = s2.endpoints;
+    if (orientation(a, b, c, d) != 0) {
+        return false;
+    }
+    WideVector normal = cross_product(b - a, c - a);
+    if (normal.is_zero()) {
+        normal = cross_product(b - a, d - a);
+    }
+    if (normal.is_zero()) {
+        // All the endpoints are on the same line.
+        return intersect(a, s2) || intersect(b, s2) || intersect(c, s1) || intersect(d, s1);
+    }
+    const size_t axis = dropped_axis(normal);
+    const int o1 = orientation_2d(a, b, c, axis);
+    const int o2 = orientation_2d(a, b, d, axis);
+    const int o3 = orientation_2d(c, d, a, axis);
+    const int o4 = orientation_2d(c, d, b, axis);
+    if (o1 * o2 < 0 && o3 * o4 < 0) {
+        return true;
+    }
+    return (o1 == 0 && intersect(c, s1)) || (o2 == 0 && intersect(d, s1)) ||
+           (o3 == 0 && intersect(a, s2)) || (o4 == 0 && intersect(b, s2));
+}
+
+[[nodiscard]] bool intersect(const LatticeSegment& s, const LatticeTriangle& t) {
+    const auto& [p, q] = s.endpoints;
+    const auto& [a, b, c] = t.vertices;
+    const int op = orientation(a, b, c, p);
+    const int oq = orientation(a, b, c, q);
+    if (op * oq > 0) {
+        return false;
+    }
+    if (op == 0 && oq == 0) {
+        for (size_t i = 0; i < 3; ++i) {
+            if (intersect(s, LatticeSegment{{t.vertices[(i + 1) % 3], t.vertices[(i + 2) % 3]}})) {
+                return true;
+            }
+        }
+        return intersect(p, t);
+    }
+    if (op == 0) {
+        return intersect(p, t);
+    }
+    if (oq == 0) {
+        return intersect(q, t);
+    }
+    // The segment crosses the plane of the triangle, and the crossing point is inside the triangle iff the segment
+    // passes every edge on the same side.
+    const int o1 = orientation(p, q, a, b);
+    const int o2 = orientation(p, q, b, c);
+    const int o3 = orientation(p, q, c, a);
+    return (o1 >= 0 && o2 >= 0 && o3 >= 0) || (o1 <= 0 && o2 <= 0 && o3 <= 0);
+}
+
+[[nodiscard]] bool intersect(const LatticeTriangle& t1, const LatticeTriangle& t2) {
+    const std::array<const LatticeTriangle*, 2> ts{&t1, &t2};
+    for (const bool i: {0, 1}) {
+        const auto& [a, b, c] = ts[!i]->vertices;
+        std::array<int, 3> orientations;
+        for (size_t j = 0; j < 3; ++j) {
+            orientations[j] = orientation(a, b, c, ts[i]->vertices[j]);
+        }
+        if (orientations[0] * orientations[1] > 0 && orientations[1] * orientations[2] > 0) {
+            return false;
+        }
+    }
+
+    // The intersection of non-coplanar triangles is a segment or a point, and its ends are on the edges of the
+    // triangles. Coplanar triangles intersect iff their edges intersect or one of them contains the other, and then
+    // the edges of the inner one are inside the outer one.
+    for (const bool i: {0, 1}) {
+        for (size_t j = 0; j < 3; ++j) {
+            const LatticeSegment edge{{ts[i]->vertices[(j + 1) % 3], ts[i]->vertices[(j + 2) % 3]}};
+            if (intersect(edge, *ts[!i])) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+template<class A, class B>
+[[nodiscard]] bool intersect(const A& a, const B& b) {
+    return intersect(b, a);
+}
+
+}
+
+int orientation(const LatticePoint& a, const LatticePoint& b, const LatticePoint& c, const LatticePoint& d) {
+    return sign(dot_product(cross_product(b - a, c - a), d - a));
+}
+
+bool are_intersecting(const QuantizedTriangle& t1, const QuantizedTriangle& t2) {
+    return std::visit([](auto&& arg1, auto&& arg2) { return intersect(arg1, arg2); },
+                      as_non_degenerate(t1), as_non_degenerate(t2));
+}
+
+}
@@ -0,0 +1,358 @@
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <utility>
+#include <variant>
+
+#include "intersection_of_two_triangles/algorithms/are_intersecting.hpp"
+#include "intersection_of_two_triangles/algorithms/mesh_index.hpp"
+#include "intersection_of_two_triangles/primitives/vector.hpp"
+
+namespace intersection_of_two_triangles {
+
+namespace {
+
+// Interleaves the lower 21 bits of the given numbers.
+[[nodiscard]] std::uint64_t morton_code(const std::array<std::uint64_t, 3>& cell) {
+    std::uint64_t result = 0;
+    for (size_t bit = 0; bit < 21; ++bit) {
+        for (size_t i = 0; i < 3; ++i) {
+            result |= ((cell[i] >> bit) & 1) << (3 * bit + i);
+        }
+    }
+    return result;
+}
+
+// Orders the points along a space-filling curve, so that neighbouring indices refer to nearby points.
+[[nodiscard]] std::vector<size_t> spatially_sorted(const std::vector<Point>& points) {
+    Box bounds;
+    for (const Point& p: points) {
+        bounds.expand(p);
+    }
+
+    std::vector<std::pair<std::uint64_t, size_t>> codes;
+    codes.reserve(points.size());
+    for (size_t index = 0; index < points.size(); ++index) {
+        std::array<std::uint64_t, 3> cell{};
+        for (size_t i = 0; i < 3; ++i) {
+            const double extent = bounds.extent(i);
+            if (extent > 0 && std::isfinite(extent)) {
+                cell[i] = static_cast<std::uint64_t>((points[index][i] - bounds.min[i]) / extent *
+                                                     ((1 << 21) - 1));
+            }
+        }
+        codes.emplace_back(morton_code(cell), index);
+    }
+    std::sort(codes.begin(), codes.end());
+
+    std::vector<size_t> result;
+    result.reserve(codes.size());
+    for (const auto& [code, index]: codes) {
+        result.push_back(index);
+    }
+    return result;
+}
+
+// The segments of a batch in the structure-of-arrays layout: `origin[i][lane]` is the i-th coordinate of the
+// first endpoint of the segment in the lane.
+struct SegmentBatch {
+    using Lanes = std::array<double, MeshIndex::batch_size>;
+
+    std::array<Lanes, 3> origin;
+    std::array<Lanes, 3> direction;
+    std::array<Lanes, 3> inverse_direction;
+    size_t length;
+};
+
+using LaneMask = std::uint32_t;
+static_assert(MeshIndex::batch_size <= 32);
+
+// Returns the lanes of `mask` whose segments cross `box`, testing them one by one in a scalar loop. Uses the slab
+// test: a segment crosses the box iff the parameter intervals in which it is between the planes of each pair of box
+// faces have a common point in [0, 1].
+[[nodiscard]] LaneMask crossing_lanes(const SegmentBatch& batch, const Box& box, const LaneMask mask) {
+    LaneMask result = 0;
+    for (size_t lane = 0; lane < batch.length; ++lane) {
+        if (!(mask >> lane & 1)) {
+            continue;
+        }
+        double enter = 0;
+        double exit = 1;
+        for (size_t i = 0; i < 3 && enter <= exit; ++i) {
+            const double o = batch.origin[i][lane];
+            if (batch.direction[i][lane] == 0) {
+                if (o < box.min[i] || box.max[i] < o) {
+                    exit = -1;
+                }
+                continue;
+            }
+            double t1 = (box.min[i] - o) * batch.inverse_direction[i][lane];
+            double t2 = (box.max[i] - o) * batch.inverse_direction[i][lane];
+            if (t1 > t2) {
+                std::swap(t1, t2);
+            }
+            enter = std::max(enter, t1);
+            exit = std::min(exit, t2);
+        }
+        result |= LaneMask{enter <= exit} << lane;
+    }
+    return result;
+}
+
+}
+
+MeshIndex::MeshIndex(std::vector<GeneralTriangle> triangles, const Tolerance& tolerance) :
+    tolerance_(tolerance), triangles_(std::move(triangles)) {
+    prepared_.reserve(triangles_.size());
+    boxes_.reserve(triangles_.size());
+    for (const GeneralTriangle& gt: triangles_) {
+        PreparedTriangle prepared{gt.as_non_degenerate(tolerance_)};
+        if (prepared.sub_objects.size() == 1) {
+            if (const auto* const t = std::get_if<Triangle>(&prepared.sub_objects[0])) {
+                prepared.plane.emplace(t->vertex(0), t->vertex(1), t->vertex(2), tolerance_);
+            }
+        }
+        prepared_.push_back(std::move(prepared));
+        boxes_.push_back(conservative_bounding_box(gt, tolerance_));
+    }
+    hierarchy_ = BoundingVolumeHierarchy(boxes_);
+}
+
+const std::vector<GeneralTriangle>& MeshIndex::triangles() const {
+    return triangles_;
+}
+
+const BoundingVolumeHierarchy& MeshIndex::hierarchy() const {
+    return hierarchy_;
+}
+
+const Tolerance& MeshIndex::tolerance() const {
+    return tolerance_;
+}
+
+const Box& MeshIndex::triangle_box(const size_t which) const {
+    assert(which < boxes_.size());
+    return boxes_[which];
+}
+
+std::vector<MeshHit> MeshIndex::intersect(const std::vector<Segment>& segments) const {
+    std::vector<MeshHit> hits;
+    if (hierarchy_.empty()) {
+        return hits;
+    }
+
+    std::vector<Point> midpoints;
+    midpoints.reserve(segments.size());
+    for (const Segment& s: segments) {
+        midpoints.push_back(s.endpoint(0) + s.as_vector() / 2);
+    }
+    const std::vector<size_t> order = spatially_sorted(midpoints);
+
+    for (size_t first = 0; first < order.size(); first += batch_size) {
+        intersect_batch(segments, order.data() + first, std::min(batch_size, order.size() - first), hits);
+    }
+
+    std::sort(hits.begin(), hits.end(), [](const MeshHit& a, const MeshHit& b) {
+        return std::pair(a.query, a.triangle) < std::pair(b.query, b.triangle);
+    });
+    return hits;
+}
+
+// The segments of the batch descend the hierarchy together, so each node is fetched once for all of them, but every
+// box and every triangle is still tested against the segments one at a time.
+void MeshIndex::intersect_batch(const std::vector<Segment>& segments, const size_t* const batch,
+                                const size_t batch_length, std::vector<MeshHit>& hits) const {
+    SegmentBatch lanes{};
+    lanes.length = batch_length;
+    std::array<Box, batch_size> segment_boxes;
+    for (size_t lane = 0; lane < batch_length; ++lane) {
+        const Segment& s = segments[batch[lane]];
+        const Vector direction = s.as_vector();
+        for (size_t i = 0; i < 3; ++i) {
+            lanes.origin[i][lane] = s.endpoint(0)[i];
+            lanes.direction[i][lane] = direction[i];
+            lanes.inverse_direction[i][lane] = 1 / direction[i];
+        }
+        segment_boxes[lane].expand(s.endpoint(0));
+        segment_boxes[lane].expand(s.endpoint(1));
+    }
+
+    const auto& nodes = hierarchy_.nodes();
+    std::vector<std::pair<size_t, LaneMask>> stack{{0, (LaneMask{1} << batch_length) - 1}};
+    while (!stack.empty()) {
+        const auto [node_index, parent_mask] = stack.back();
+        stack.pop_back();
+        const auto& node = nodes[node_index];
+        const LaneMask mask = crossing_lanes(lanes, node.box, parent_mask);
+        if (!mask) {
+            continue;
+        }
+        if (!node.is_leaf()) {
+            stack.emplace_back(node.first, mask);
+            stack.emplace_back(node_index + 1, mask);
+            continue;
+        }
+        for (size_t i = node.first; i < node.first + node.count; ++i) {
+            const size_t triangle = hierarchy_.primitives()[i];
+            const PreparedTriangle& prepared = prepared_[triangle];
+            for (size_t lane = 0; lane < batch_length; ++lane) {
+                if (!(mask >> lane & 1) || !are_intersecting(segment_boxes[lane], boxes_[triangle])) {
+                    continue;
+                }
+                const Segment& s = segments[batch[lane]];
+                if (prepared.plane) {
+                    const auto result = test_segment_against_triangle(
+                        s, std::get<Triangle>(prepared.sub_objects[0]), *prepared.plane, tolerance_);
+                    if (result.intersecting) {
+                        hits.push_back({batch[lane], triangle, result.parameter});
+                    }
+                    continue;
+                }
+                for (const auto& sub_object: prepared.sub_objects) {
+                    if (std::visit([&](auto&& arg) { return are_intersecting(s, arg, tolerance_); }, sub_object)) {
+                        hits.push_back({batch[lane], triangle});
+                        break;
+                    }
+                }
+            }
+        }
+    }
+}
+
+std::vector<MeshHit> MeshIndex::locate(const std::vector<Point>& points) const {
+    std::vector<MeshHit> hits;
+    if (hierarchy_.empty()) {
+        return hits;
+    }
+
+    const auto& nodes = hierarchy_.nodes();
+    std::vector<size_t> stack;
+    for (size_t query = 0; query < points.size(); ++query) {
+        const Point& p = points[query];
+        stack.assign(1, 0);
+        while (!stack.empty()) {
+            const auto& node = nodes[stack.back()];
+            const size_t node_index = stack.back();
+            stack.pop_back();
+            if (!node.box.contains(p)) {
+                continue;
+            }
+            if (!node.is_leaf()) {
+                stack.push_back(node.first);
+                stack.push_back(node_index + 1);
+                continue;
+            }
+            for (size_t i = node.first; i < node.first + node.count; ++i) {
+                const size_t triangle = hierarchy_.primitives()[i];
+                const PreparedTriangle& prepared = prepared_[triangle];
+                if (!boxes_[triangle].contains(p)) {
+                    continue;
+                }
+                const auto contains_point = [&](const auto& sub_object) {
+                    return std::visit([&](auto&& arg) { return are_intersecting(p, arg, tolerance_); }, sub_object);
+                };
+                const bool contains =
+                    prepared.plane
+                        ? are_intersecting(p, std::get<Triangle>(prepared.sub_objects[0]), *prepared.plane, tolerance_)
+                        : std::any_of(prepared.sub_objects.begin(), prepared.sub_objects.end(), contains_point);
+                if (contains) {
+                    hits.push_back({query, triangle});
+                }
+            }
+        }
+    }
+
+    std::sort(hits.begin(), hits.end(), [](const MeshHit& a, const MeshHit& b) {
+        return std::pair(a.query, a.triangle) < std::pair(b.query, b.triangle);
+    });
+    return hits;
+}
+
+namespace {
+
+// Calls `visit(a, b)` for all pairs of primitives of the leaves of the hierarchies whose boxes intersect, where
+// the boxes of the second hierarchy are mapped with `map_box` first. The node with the larger box is split first,
+// so the boxes of the pairs on the stack shrink evenly.
+template<class MapBox, class Visit>
+void for_each_overlapping_leaf_pair(const BoundingVolumeHierarchy& hierarchy1,
+                                    const BoundingVolumeHierarchy& hierarchy2, MapBox&& map_box, Visit&& visit) {
+    if (hierarchy1.empty() || hierarchy2.empty()) {
+        return;
+    }
+    const auto& nodes1 = hierarchy1.nodes();
+    const auto& nodes2 = hierarchy2.nodes();
+    const auto size = [](const Box& box) {
+        return box.extent(0) + box.extent(1) + box.extent(2);
+    };
+
+    std::vector<std::pair<size_t, size_t>> stack{{0, 0}};
+    while (!stack.empty()) {
+        const auto [index1, index2] = stack.back();
+        stack.pop_back();
+        const auto& node1 = nodes1[index1];
+        const auto& node2 = nodes2[index2];
+        const Box box2 = map_box(node2.box);
+        if (!are_intersecting(node1.box, box2)) {
+            continue;
+        }
+        if (!node1.is_leaf() && (node2.is_leaf() || size(node1.box) >= size(box2))) {
+            stack.emplace_back(index1 + 1, index2);
+            stack.emplace_back(node1.first, index2);
+            continue;
+        }
+        if (!node2.is_leaf()) {
+            stack.emplace_back(index1, index2 + 1);
+            stack.emplace_back(index1, node2.first);
+            continue;
+        }
+        for (size_t i = node1.first; i < node1.first + node1.count; ++i) {
+            for (size_t j = node2.first; j < node2.first + node2.count; ++j) {
+                visit(hierarchy1.primitives()[i], hierarchy2.primitives()[j]);
+            }
+        }
+    }
+}
+
+}
+
+std::vector<std::pair<size_t, size_t>> MeshIndex::intersect(const MeshIndex& other) const {
+    std::vector<std::pair<size_t, size_t>> result;
+    for_each_overlapping_leaf_pair(hierarchy_, other.hierarchy_, [](const Box& box) { return box; },
+                                   [&](const size_t a, const size_t b) {
+                                       if (are_intersecting(boxes_[a], other.boxes_[b]) &&
+                                           are_intersecting(prepared_[a].sub_objects, other.prepared_[b].sub_objects,
+                                                            tolerance_)) {
+                                           result.emplace_back(a, b);
+                                       }
+                                   });
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+std::vector<std::pair<size_t, size_t>> MeshIndex::intersect(const MeshIndex& other,
+                                                            const RigidTransform& other_to_this) const {
+    // The triangles of `other` are transformed and decomposed when they are first reached.
+    struct Transformed {
+        GeneralTriangle::Decomposed sub_objects;
+        Box box;
+    };
+    std::vector<std::optional<Transformed>> transformed(other.triangles_.size());
+    std::vector<std::pair<size_t, size_t>> result;
+    for_each_overlapping_leaf_pair(hierarchy_, other.hierarchy_, other_to_this, [&](const size_t a, const size_t b) {
+        if (!transformed[b]) {
+            const GeneralTriangle triangle = other_to_this(other.triangles_[b]);
+            transformed[b] = {triangle.as_non_degenerate(tolerance_),
+                              conservative_bounding_box(triangle, tolerance_)};
+        }
+        if (are_intersecting(boxes_[a], transformed[b]->box) &&
+            are_intersecting(prepared_[a].sub_objects, transformed[b]->sub_objects, tolerance_)) {
+            result.emplace_back(a, b);
+        }
+    });
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+}
@@ -0,0 +1,169 @@
+#include <algorithm>
+#include <cassert>
+#include <tuple>
+
+#include "intersection_of_two_triangles/algorithms/scene.hpp"
+
+namespace intersection_of_two_triangles {
+
+namespace {
+
+[[nodiscard]] Box world_box(const MeshIndex& mesh, const RigidTransform& mesh_to_world) {
+    return mesh.hierarchy().empty() ? Box() : mesh_to_world(mesh.hierarchy().nodes()[0].box);
+}
+
+void sort_hits(std::vector<SceneHit>& hits) {
+    std::sort(hits.begin(), hits.end(), [](const SceneHit& a, const SceneHit& b) {
+        return std::tie(a.query, a.instance, a.triangle) < std::tie(b.query, b.instance, b.triangle);
+    });
+}
+
+}
+
+size_t Scene::add_mesh(std::shared_ptr<const MeshIndex> mesh) {
+    assert(mesh);
+    meshes_.push_back(std::move(mesh));
+    return meshes_.size() - 1;
+}
+
+size_t Scene::add_instance(const size_t mesh, const RigidTransform& mesh_to_world) {
+    assert(mesh < meshes_.size());
+    instances_.push_back({mesh, mesh_to_world, mesh_to_world.inverse()});
+    instance_boxes_.push_back(world_box(*meshes_[mesh], mesh_to_world));
+    rebuild();
+    return instances_.size() - 1;
+}
+
+void Scene::set_transform(const size_t instance, const RigidTransform& mesh_to_world) {
+    assert(instance < instances_.size());
+    instances_[instance].mesh_to_world = mesh_to_world;
+    instances_[instance].world_to_mesh = mesh_to_world.inverse();
+    instance_boxes_[instance] = world_box(*meshes_[instances_[instance].mesh], mesh_to_world);
+    top_level_.refit(instance_boxes_);
+}
+
+void Scene::rebuild() {
+    top_level_ = BoundingVolumeHierarchy(instance_boxes_);
+}
+
+size_t Scene::number_of_instances() const {
+    return instances_.size();
+}
+
+const MeshIndex& Scene::mesh_of(const size_t instance) const {
+    return *meshes_[instances_[instance].mesh];
+}
+
+const RigidTransform& Scene::transform(const size_t instance) const {
+    return instances_[instance].mesh_to_world;
+}
+
+const BoundingVolumeHierarchy& Scene::top_level() const {
+    return top_level_;
+}
+
+template<class Visit>
+void Scene::for_each_instance_overlapping(const Box& box, Visit&& visit) const {
+    if (top_level_.empty()) {
+        return;
+    }
+    const auto& nodes = top_level_.nodes();
+    std::vector<size_t> stack{0};
+    while (!stack.empty()) {
+        const auto& node = nodes[stack.back()];
+        const size_t index = stack.back();
+        stack.pop_back();
+        if (!are_intersecting(node.box, box)) {
+            continue;
+        }
+        if (!node.is_leaf()) {
+            stack.push_back(node.first);
+            stack.push_back(index + 1);
+            continue;
+        }
+        for (size_t i = node.first; i < node.first + node.count; ++i) {
+            const size_t instance = top_level_.primitives()[i];
+            if (are_intersecting(instance_boxes_[instance], box)) {
+                visit(instance);
+            }
+        }
+    }
+}
+
+std::vector<SceneHit> Scene::intersect(const std::vector<Segment>& segments) const {
+    // The segments are grouped by the instances they may cross, so that each mesh answers a batch of segments.
+    std::vector<std::vector<size_t>> candidates(instances_.size());
+    for (size_t query = 0; query < segments.size(); ++query) {
+        Box box;
+        box.expand(segments[query].endpoint(0));
+        box.expand(segments[query].endpoint(1));
+        for_each_instance_overlapping(box, [&](const size_t instance) { candidates[instance].push_back(query); });
+    }
+
+    std::vector<SceneHit> hits;
+    for (size_t instance = 0; instance < instances_.size(); ++instance) {
+        if (candidates[instance].empty()) {
+            continue;
+        }
+        const MeshIndex& mesh = mesh_of(instance);
+        std::vector<Segment> local;
+        local.reserve(candidates[instance].size());
+        for (const size_t query: candidates[instance]) {
+            local.push_back(instances_[instance].world_to_mesh(segments[query], mesh.tolerance()));
+        }
+        for (const MeshHit& hit: mesh.intersect(local)) {
+            hits.push_back({candidates[instance][hit.query], instance, hit.triangle, hit.parameter});
+        }
+    }
+    sort_hits(hits);
+    return hits;
+}
+
+std::vector<SceneHit> Scene::locate(const std::vector<Point>& points) const {
+    std::vector<std::vector<size_t>> candidates(instances_.size());
+    for (size_t query = 0; query < points.size(); ++query) {
+        Box box;
+        box.expand(points[query]);
+        for_each_instance_overlapping(box, [&](const size_t instance) { candidates[instance].push_back(query); });
+    }
+
+    std::vector<SceneHit> hits;
+    for (size_t instance = 0; instance < instances_.size(); ++instance) {
+        if (candidates[instance].empty()) {
+            continue;
+        }
+        std::vector<Point> local;
+        local.reserve(candidates[instance].size());
+        for (const size_t query: candidates[instance]) {
+            local.push_back(instances_[instance].world_to_mesh(points[query]));
+        }
+        for (const MeshHit& hit: mesh_of(instance).locate(local)) {
+            hits.push_back({candidates[instance][hit.query], instance, hit.triangle, std::nullopt});
+        }
+    }
+    sort_hits(hits);
+    return hits;
+}
+
+std::vector<InstanceContact> Scene::find_intersecting_instances() const {
+    std::vector<InstanceContact> result;
+    for (size_t first = 0; first < instances_.size(); ++first) {
+        for_each_instance_overlapping(instance_boxes_[first], [&](const size_t second) {
+            if (second <= first) {
+                return;
+            }
+            const RigidTransform second_to_first = instances_[first].world_to_mesh * instances_[second].mesh_to_world;
+            std::vector<std::pair<size_t, size_t>> triangles =
+                mesh_of(first).intersect(mesh_of(second), second_to_first);
+            if (!triangles.empty()) {
+                result.push_back({first, second, std::move(triangles)});
+            }
+        });
+    }
+    std::sort(result.begin(), result.end(), [](const InstanceContact& a, const InstanceContact& b) {
+        return std::pair(a.first_instance, a.second_instance) < std::pair(b.first_instance, b.second_instance);
+    });
+    return result;
+}
+
+}
@@ -0,0 +1,236 @@
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+#include "intersection_of_two_triangles/algorithms/are_intersecting.hpp"
+#include "intersection_of_two_triangles/algorithms/uniform_grid.hpp"
+#include "intersection_of_two_triangles/primitives/segment.hpp"
+#include "intersection_of_two_triangles/primitives/triangle.hpp"
+#include "intersection_of_two_triangles/utility/concurrent_disjoint_sets.hpp"
+
+namespace intersection_of_two_triangles {
+
+namespace {
+
+constexpr size_t chunk_size = 1024;
+
+// The cells are clamped to this range, so the coordinates of far away or infinite points don't overflow.
+constexpr double max_cell_coordinate = static_cast<double>(std::int64_t{1} << 52);
+
+[[nodiscard]] std::uint64_t hash(const std::array<std::int64_t, 3>& cell) {
+    std::uint64_t result = 0;
+    for (const std::int64_t coordinate: cell) {
+        result = (result ^ static_cast<std::uint64_t>(coordinate)) * 0x9E3779B97F4A7C15;
+        result ^= result >> 29;
+    }
+    return result;
+}
+
+[[nodiscard]] std::vector<GeneralTriangle::Decomposed> decompose(const std::vector<GeneralTriangle>& triangles,
+                                                                 const Tolerance& tolerance, const size_t threads) {
+    std::vector<GeneralTriangle::Decomposed> result(triangles.size());
+    parallel_for(triangles.size(), threads, chunk_size, [&](size_t, const size_t begin, const size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            result[i] = triangles[i].as_non_degenerate(tolerance);
+        }
+    });
+    return result;
+}
+
+[[nodiscard]] size_t next_power_of_two(const size_t value) {
+    size_t result = 1;
+    while (result < value) {
+        result *= 2;
+    }
+    return result;
+}
+
+}
+
+UniformGrid::UniformGrid(const std::vector<GeneralTriangle>& triangles, const Tolerance& tolerance,
+                         const size_t threads, const double cell_size) :
+    cell_size_(cell_size), boxes_(triangles.size()) {
+    std::vector<double> extents_sums(std::max<size_t>(1, threads), 0);
+    parallel_for(triangles.size(), threads, chunk_size, [&](const size_t thread, const size_t begin, const size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            boxes_[i] = conservative_bounding_box(triangles[i], tolerance);
+            const double extent = boxes_[i].extent(boxes_[i].longest_axis());
+            extents_sums[thread] += std::isfinite(extent) ? extent : 0;
+        }
+    });
+    if (cell_size_ == 0) {
+        double extents_sum = 0;
+        for (const double sum: extents_sums) {
+            extents_sum += sum;
+        }
+        cell_size_ = triangles.empty() ? 0 : extents_sum / triangles.size();
+    }
+    if (!(cell_size_ > 0) || !std::isfinite(cell_size_)) {
+        cell_size_ = 1;
+    }
+
+    // The first pass counts the cells of each triangle, so that the second one can write the entries in parallel.
+    std::vector<size_t> offsets(triangles.size() + 1, 0);
+    parallel_for(triangles.size(), threads, chunk_size, [&](size_t, const size_t begin, const size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const Cell min = cell_of(boxes_[i].min);
+            const Cell max = cell_of(boxes_[i].max);
+            double cells = 1;
+            for (size_t j = 0; j < 3; ++j) {
+                cells *= static_cast<double>(max[j] - min[j]) + 1;
+            }
+            offsets[i + 1] = cells <= max_cells_per_triangle ? static_cast<size_t>(cells) : 0;
+        }
+    });
+    for (size_t i = 0; i < triangles.size(); ++i) {
+        if (offsets[i + 1] == 0) {
+            oversized_.push_back(i);
+        }
+        offsets[i + 1] += offsets[i];
+    }
+
+    std::vector<Entry> unordered(offsets.back());
+    parallel_for(triangles.size(), threads, chunk_size, [&](size_t, const size_t begin, const size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            if (offsets[i] == offsets[i + 1]) {
+                continue;
+            }
+            const Cell min = cell_of(boxes_[i].min);
+            const Cell max = cell_of(boxes_[i].max);
+            size_t position = offsets[i];
+            for (std::int64_t x = min[0]; x <= max[0]; ++x) {
+                for (std::int64_t y = min[1]; y <= max[1]; ++y) {
+                    for (std::int64_t z = min[2]; z <= max[2]; ++z) {
+                        unordered[position++] = {{x, y, z}, i};
+                    }
+                }
+            }
+        }
+    });
+
+    // Distributes the entries into the hash buckets with a parallel counting sort.
+    const size_t number_of_buckets = next_power_of_two(unordered.size());
+    std::vector<std::atomic<size_t>> cursors(number_of_buckets + 1);
+    parallel_for(unordered.size(), threads, chunk_size, [&](size_t, const size_t begin, const size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            cursors[(hash(unordered[i].cell) & (number_of_buckets - 1)) + 1].fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+    bucket_offsets_.resize(number_of_buckets + 1);
+    for (size_t i = 1; i <= number_of_buckets; ++i) {
+        bucket_offsets_[i] = bucket_offsets_[i - 1] + cursors[i];
+        cursors[i - 1] = bucket_offsets_[i - 1];
+    }
+    entries_.resize(unordered.size());
+    parallel_for(unordered.size(), threads, chunk_size, [&](size_t, const size_t begin, const size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const size_t bucket = hash(unordered[i].cell) & (number_of_buckets - 1);
+            entries_[cursors[bucket].fetch_add(1, std::memory_order_relaxed)] = unordered[i];
+        }
+    });
+}
+
+double UniformGrid::cell_size() const {
+    return cell_size_;
+}
+
+size_t UniformGrid::number_of_entries() const {
+    return entries_.size();
+}
+
+UniformGrid::Cell UniformGrid::cell_of(const Point& p) const {
+    Cell result;
+    for (size_t i = 0; i < 3; ++i) {
+        const double coordinate = std::floor(p[i] / cell_size_);
+        result[i] = static_cast<std::int64_t>(std::clamp(coordinate, -max_cell_coordinate, max_cell_coordinate));
+    }
+    return result;
+}
+
+void UniformGrid::for_each_candidate_pair(
+    const size_t threads, const std::function<void(size_t thread, size_t a, size_t b)>& visitor) const {
+    const size_t number_of_buckets = bucket_offsets_.empty() ? 0 : bucket_offsets_.size() - 1;
+    parallel_for(number_of_buckets, threads, chunk_size, [&](const size_t thread, const size_t begin, const size_t end) {
+        std::vector<Entry> bucket;
+        for (size_t b = begin; b < end; ++b) {
+            // Different cells can share a bucket, so the entries are grouped by the cells first.
+            bucket.assign(entries_.begin() + bucket_offsets_[b], entries_.begin() + bucket_offsets_[b + 1]);
+            std::sort(bucket.begin(), bucket.end(), [](const Entry& e1, const Entry& e2) {
+                return std::pair(e1.cell, e1.triangle) < std::pair(e2.cell, e2.triangle);
+            });
+            for (size_t first = 0, last = 0; first < bucket.size(); first = last) {
+                while (last < bucket.size() && bucket[last].cell == bucket[first].cell) {
+                    ++last;
+                }
+                for (size_t i = first; i < last; ++i) {
+                    for (size_t j = i + 1; j < last; ++j) {
+                        const Box& box1 = boxes_[bucket[i].triangle];
+                        const Box& box2 = boxes_[bucket[j].triangle];
+                        if (!are_intersecting(box1, box2)) {
+                            continue;
+                        }
+                        const Point overlap_min(std::max(box1.min.x(), box2.min.x()),
+                                                std::max(box1.min.y(), box2.min.y()),
+                                                std::max(box1.min.z(), box2.min.z()));
+                        if (cell_of(overlap_min) == bucket[first].cell) {
+                            visitor(thread, bucket[i].triangle, bucket[j].triangle);
+                        }
+                    }
+                }
+            }
+        }
+    });
+
+    parallel_for(oversized_.size(), threads, 1, [&](const size_t thread, const size_t begin, const size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const size_t a = oversized_[i];
+            for (size_t b = 0; b < boxes_.size(); ++b) {
+                // The pairs of oversized triangles are reported once, when `a` is the first of them.
+                const bool b_is_oversized = std::binary_search(oversized_.begin(), oversized_.end(), b);
+                if (a != b && !(b_is_oversized && b < a) && are_intersecting(boxes_[a], boxes_[b])) {
+                    visitor(thread, std::min(a, b), std::max(a, b));
+                }
+            }
+        }
+    });
+}
+
+std::vector<std::pair<size_t, size_t>> find_intersecting_pairs(const std::vector<GeneralTriangle>& triangles,
+                                                               const Tolerance& tolerance, const size_t threads,
+                                                               const std::function<bool(size_t, size_t)>& filter) {
+    const std::vector<GeneralTriangle::Decomposed> decomposed = decompose(triangles, tolerance, threads);
+    const UniformGrid grid(triangles, tolerance, threads);
+    std::vector<std::vector<std::pair<size_t, size_t>>> found(std::max<size_t>(1, threads));
+    grid.for_each_candidate_pair(threads, [&](const size_t thread, const size_t a, const size_t b) {
+        if ((!filter || filter(a, b)) && are_intersecting(decomposed[a], decomposed[b], tolerance)) {
+            found[thread].emplace_back(a, b);
+        }
+    });
+
+    std::vector<std::pair<size_t, size_t>> result;
+    for (const auto& pairs: found) {
+        result.insert(result.end(), pairs.begin(), pairs.end());
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+std::vector<size_t> find_intersecting_components(const std::vector<GeneralTriangle>& triangles,
+                                                 const Tolerance& tolerance, const size_t threads) {
+    const std::vector<GeneralTriangle::Decomposed> decomposed = decompose(triangles, tolerance, threads);
+    const UniformGrid grid(triangles, tolerance, threads);
+    ConcurrentDisjointSets components(triangles.size());
+    grid.for_each_candidate_pair(threads, [&](size_t, const size_t a, const size_t b) {
+        if (!components.are_united(a, b) && are_intersecting(decomposed[a], decomposed[b], tolerance)) {
+            components.unite(a, b);
+        }
+    });
+
+    std::vector<size_t> result(triangles.size());
+    for (size_t i = 0; i < triangles.size(); ++i) {
+        result[i] = components.find(i);
+    }
+    return result;
+}
+
+}
@@ -0,0 +1,142 @@
+#include <algorithm>
+#include <cmath>
+
+#include "intersection_of_two_triangles/algorithms/are_intersecting.hpp"
+#include "intersection_of_two_triangles/algorithms/voxelizer.hpp"
+
+namespace intersection_of_two_triangles {
+
+namespace {
+
+// The range of the cells along an axis whose closed boxes may touch [min, max], widened by a cell on both sides for the
+// rounding of the division. The conservative bounding boxes of the triangles are passed, since the triangles touch the
+// cells up to the tolerance, which may exceed the size of a cell for large coordinates.
+// Returns an empty range if [min, max] is outside the grid.
+[[nodiscard]] std::array<size_t, 2> cell_range(const VoxelGrid& grid, const size_t axis, const double min,
+                                               const double max) {
+    const double size = static_cast<double>(grid.dimensions[axis]);
+    const double first = std::floor((min - grid.origin[axis]) / grid.cell_size) - 1;
+    const double last = std::floor((max - grid.origin[axis]) / grid.cell_size) + 1;
+    if (!(last >= 0 && first < size)) {
+        return {1, 0};
+    }
+    return {static_cast<size_t>(std::max(first, 0.0)), static_cast<size_t>(std::min(last, size - 1))};
+}
+
+// Calls `mark(layer, index)` for the cells touched by the triangles, calling it for each layer of cells along z from
+// a single thread, in the order of the layers' triangles.
+template<class Mark>
+void voxelize(const std::vector<GeneralTriangle>& triangles, const VoxelGrid& grid, const Tolerance& tolerance,
+              const size_t threads, Mark&& mark) {
+    const size_t layers = grid.dimensions[2];
+    std::vector<Box> boxes(triangles.size());
+    std::vector<std::array<size_t, 2>> layer_ranges(triangles.size());
+    // The triangles of the layer `k` are `layer_triangles[layer_offsets[k]] ... layer_triangles[layer_offsets[k + 1]
+    // - 1]`, filled with a counting sort.
+    std::vector<size_t> layer_offsets(layers + 1, 0);
+    for (size_t t = 0; t < triangles.size(); ++t) {
+        boxes[t] = conservative_bounding_box(triangles[t], tolerance);
+        layer_ranges[t] = cell_range(grid, 2, boxes[t].min.z(), boxes[t].max.z());
+        for (size_t k = layer_ranges[t][0]; k <= layer_ranges[t][1] && k < layers; ++k) {
+            ++layer_offsets[k + 1];
+        }
+    }
+    for (size_t k = 0; k < layers; ++k) {
+        layer_offsets[k + 1] += layer_offsets[k];
+    }
+    std::vector<size_t> layer_triangles(layer_offsets[layers]);
+    std::vector<size_t> cursors(layer_offsets.begin(), layer_offsets.end() - 1);
+    for (size_t t = 0; t < triangles.size(); ++t) {
+        for (size_t k = layer_ranges[t][0]; k <= layer_ranges[t][1] && k < layers; ++k) {
+            layer_triangles[cursors[k]++] = t;
+        }
+    }
+
+    parallel_for(layers, threads, 1, [&](size_t, const size_t begin, const size_t end) {
+        for (size_t k = begin; k < end; ++k) {
+            for (size_t p = layer_offsets[k]; p < layer_offsets[k + 1]; ++p) {
+                const size_t t = layer_triangles[p];
+                const auto xs = cell_range(grid, 0, boxes[t].min.x(), boxes[t].max.x());
+                const auto ys = cell_range(grid, 1, boxes[t].min.y(), boxes[t].max.y());
+                for (size_t j = ys[0]; j <= ys[1] && j < grid.dimensions[1]; ++j) {
+                    for (size_t i = xs[0]; i <= xs[1] && i < grid.dimensions[0]; ++i) {
+                        const VoxelGrid::Cell cell{i, j, k};
+                        if (are_intersecting(triangles[t], grid.cell_box(cell), tolerance)) {
+                            mark(k, grid.index(cell));
+                        }
+                    }
+                }
+            }
+        }
+    });
+}
+
+}
+
+VoxelGrid VoxelGrid::around(const std::vector<GeneralTriangle>& triangles, const double cell_size) {
+    Box bounds;
+    for (const GeneralTriangle& triangle: triangles) {
+        bounds.expand(bounding_box(triangle));
+    }
+    VoxelGrid result;
+    result.cell_size = cell_size;
+    if (bounds.is_empty()) {
+        return result;
+    }
+    result.origin = bounds.min;
+    for (size_t i = 0; i < 3; ++i) {
+        result.dimensions[i] = std::max<size_t>(1, static_cast<size_t>(std::ceil(bounds.extent(i) / cell_size)));
+    }
+    return result;
+}
+
+size_t VoxelGrid::number_of_cells() const {
+    return dimensions[0] * dimensions[1] * dimensions[2];
+}
+
+Box VoxelGrid::cell_box(const Cell& cell) const {
+    Point min;
+    Point max;
+    for (size_t i = 0; i < 3; ++i) {
+        min[i] = origin[i] + static_cast<double>(cell[i]) * cell_size;
+        max[i] = origin[i] + static_cast<double>(cell[i] + 1) * cell_size;
+    }
+    return {min, max};
+}
+
+size_t VoxelGrid::index(const Cell& cell) const {
+    return (cell[2] * dimensions[1] + cell[1]) * dimensions[0] + cell[0];
+}
+
+VoxelGrid::Cell VoxelGrid::cell(const size_t index) const {
+    return {index % dimensions[0], index / dimensions[0] % dimensions[1], index / dimensions[0] / dimensions[1]};
+}
+
+std::vector<std::uint8_t> voxelize_dense(const std::vector<GeneralTriangle>& triangles, const VoxelGrid& grid,
+                                         const Tolerance& tolerance, const size_t threads) {
+    std::vector<std::uint8_t> result(grid.number_of_cells(), 0);
+    voxelize(triangles, grid, tolerance, threads, [&](size_t, const size_t index) {
+        result[index] = 1;
+    });
+    return result;
+}
+
+std::vector<size_t> voxelize_sparse(const std::vector<GeneralTriangle>& triangles, const VoxelGrid& grid,
+                                    const Tolerance& tolerance, const size_t threads) {
+    std::vector<std::vector<size_t>> layers(grid.dimensions[2]);
+    voxelize(triangles, grid, tolerance, threads, [&](const size_t layer, const size_t index) {
+        layers[layer].push_back(index);
+    });
+
+    // The indices of a layer are less than the indices of the next one.
+    std::vector<size_t> result;
+    for (std::vector<size_t>& layer: layers) {
+        std::sort(layer.begin(), layer.end());
+        layer.erase(std::unique(layer.begin(), layer.end()), layer.end());
+        result.insert(result.end(), layer.begin(), layer.end());
+        std::vector<size_t>().swap(layer);
+    }
+    return result;
+}
+
+}
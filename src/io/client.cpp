@@ -0,0 +1,137 @@
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "intersection_of_two_triangles/exception.hpp"
+#include "intersection_of_two_triangles/io/client.hpp"
+
+namespace intersection_of_two_triangles {
+
+namespace {
+
+void append_point(std::string& payload, const Point& p) {
+    for (size_t i = 0; i < 3; ++i) {
+        append(payload, p[i]);
+    }
+}
+
+void append_triangle(std::string& payload, const GeneralTriangle& triangle) {
+    for (size_t i = 0; i < 3; ++i) {
+        append_point(payload, triangle.vertices[i]);
+    }
+}
+
+}
+
+Client::Client(const std::string& socket_path) {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (socket_path.size() >= sizeof(address.sun_path)) {
+        throw Exception(socket_path + ": the socket path is too long");
+    }
+    std::memcpy(address.sun_path, socket_path.c_str(), socket_path.size() + 1);
+    descriptor_ = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (descriptor_ < 0 || connect(descriptor_, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+        const Exception error(socket_path + ": " + std::strerror(errno));
+        if (descriptor_ >= 0) {
+            close(descriptor_);
+        }
+        throw error;
+    }
+}
+
+Client::~Client() {
+    close(descriptor_);
+}
+
+MeshId Client::upload_mesh(const std::vector<GeneralTriangle>& triangles) {
+    std::string payload;
+    payload.reserve(sizeof(std::uint64_t) + triangles.size() * 9 * sizeof(double));
+    append(payload, std::uint64_t{triangles.size()});
+    for (const GeneralTriangle& triangle: triangles) {
+        append_triangle(payload, triangle);
+    }
+    return PayloadReader(call(Request::upload_mesh, payload)).read<MeshId>();
+}
+
+MeshId Client::load_mesh_file(const std::string& path) {
+    return PayloadReader(call(Request::load_mesh_file, path)).read<MeshId>();
+}
+
+void Client::drop_mesh(const MeshId id) {
+    std::string payload;
+    append(payload, id);
+    static_cast<void>(call(Request::drop_mesh, payload));
+}
+
+std::vector<bool> Client::are_intersecting(const std::vector<TrianglePair>& pairs) {
+    std::string payload;
+    payload.reserve(sizeof(std::uint64_t) + pairs.size() * 18 * sizeof(double));
+    append(payload, std::uint64_t{pairs.size()});
+    for (const TrianglePair& pair: pairs) {
+        append_triangle(payload, pair[0]);
+        append_triangle(payload, pair[1]);
+    }
+    const std::string_view response = call(Request::check_pairs, payload);
+    if (response.size() != pairs.size()) {
+        throw Exception("the server answered " + std::to_string(response.size()) + " of " +
+                        std::to_string(pairs.size()) + " pairs");
+    }
+    std::vector<bool> result(pairs.size());
+    for (size_t i = 0; i < pairs.size(); ++i) {
+        result[i] = response[i] != 0;
+    }
+    return result;
+}
+
+std::vector<std::pair<size_t, size_t>> Client::intersect(const MeshId first, const MeshId second) {
+    std::string payload;
+    append(payload, first);
+    append(payload, second);
+    PayloadReader reader(call(Request::intersect_meshes, payload));
+    std::vector<std::pair<size_t, size_t>> result(reader.read_count(2 * sizeof(std::uint64_t)));
+    for (auto& [a, b]: result) {
+        a = reader.read<std::uint64_t>();
+        b = reader.read<std::uint64_t>();
+    }
+    return result;
+}
+
+std::vector<MeshHit> Client::intersect(const MeshId id, const std::vector<Segment>& segments) {
+    std::string payload;
+    payload.reserve(2 * sizeof(std::uint64_t) + segments.size() * 6 * sizeof(double));
+    append(payload, id);
+    append(payload, std::uint64_t{segments.size()});
+    for (const Segment& segment: segments) {
+        append_point(payload, segment.endpoint(0));
+        append_point(payload, segment.endpoint(1));
+    }
+    PayloadReader reader(call(Request::intersect_segments, payload));
+    std::vector<MeshHit> result(reader.read_count(2 * sizeof(std::uint64_t) + sizeof(double)));
+    for (MeshHit& hit: result) {
+        hit.query = reader.read<std::uint64_t>();
+        hit.triangle = reader.read<std::uint64_t>();
+        if (const auto parameter = reader.read<double>(); !std::isnan(parameter)) {
+            hit.parameter = parameter;
+        }
+    }
+    return result;
+}
+
+std::string_view Client::call(const Request request, const std::string_view payload) {
+    write_frame(descriptor_, static_cast<std::uint64_t>(request), payload);
+    const std::optional<std::uint64_t> status = read_frame(descriptor_, response_);
+    if (!status) {
+        throw Exception("the server closed the connection");
+    }
+    if (*status != static_cast<std::uint64_t>(Status::ok)) {
+        throw Exception(response_);
+    }
+    return response_;
+}
+
+}
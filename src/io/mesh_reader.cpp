@@ -0,0 +1,280 @@
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include "intersection_of_two_triangles/exception.hpp"
+#include "intersection_of_two_triangles/io/mesh_reader.hpp"
+#include "intersection_of_two_triangles/utility/mapped_file.hpp"
+
+namespace intersection_of_two_triangles {
+
+namespace {
+
+static_assert(std::numeric_limits<float>::is_iec559, "binary STL stores IEEE 754 floats");
+
+constexpr size_t stl_header_size = 80;
+constexpr size_t stl_record_size = 50;
+// The chunks of an OBJ file are at least this large, so the small files are parsed by one thread.
+constexpr size_t min_obj_chunk_size = 1 << 20;
+
+[[nodiscard]] size_t line_of(const std::string_view contents, const size_t offset) {
+    return static_cast<size_t>(std::count(contents.begin(), contents.begin() + offset, '\n')) + 1;
+}
+
+[[nodiscard]] Exception error_at(const std::string& path, const std::string_view contents, const size_t offset,
+                                 const std::string& reason) {
+    return Exception(path + ": line " + std::to_string(line_of(contents, offset)) + ": " + reason);
+}
+
+[[nodiscard]] bool is_blank(const char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+// Reads whitespace-separated tokens of a single line or of the whole text.
+class Tokenizer {
+public:
+    explicit Tokenizer(const std::string_view text) : text_(text) {}
+
+    [[nodiscard]] size_t position() const {
+        return position_;
+    }
+
+    // Returns an empty token at the end of the text.
+    [[nodiscard]] std::string_view next() {
+        while (position_ < text_.size() && (is_blank(text_[position_]) || text_[position_] == '\n')) {
+            ++position_;
+        }
+        const size_t begin = position_;
+        while (position_ < text_.size() && !is_blank(text_[position_]) && text_[position_] != '\n') {
+            ++position_;
+        }
+        return text_.substr(begin, position_ - begin);
+    }
+
+private:
+    std::string_view text_;
+    size_t position_ = 0;
+};
+
+template<class Number>
+[[nodiscard]] std::optional<Number> parse_number(std::string_view token) {
+    // `std::from_chars` rejects the plus sign.
+    if (!token.empty() && token[0] == '+') {
+        token.remove_prefix(1);
+    }
+    Number result{};
+    const auto [end, error] = std::from_chars(token.data(), token.data() + token.size(), result);
+    if (error != std::errc() || end != token.data() + token.size()) {
+        return std::nullopt;
+    }
+    return result;
+}
+
+[[nodiscard]] Mesh read_binary_stl(const std::string_view contents, const size_t number_of_facets,
+                                   const size_t threads) {
+    Mesh mesh;
+    mesh.vertices.resize(3 * number_of_facets);
+    mesh.faces.resize(number_of_facets);
+    const char* const records = contents.data() + stl_header_size + sizeof(std::uint32_t);
+    parallel_for(number_of_facets, threads, 1 << 16, [&](size_t, const size_t begin, const size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            // The normal precedes the vertices, and it is recomputed from them when needed.
+            std::array<float, 9> coordinates;
+            std::memcpy(coordinates.data(), records + i * stl_record_size + 3 * sizeof(float), sizeof(coordinates));
+            for (size_t j = 0; j < 3; ++j) {
+                mesh.vertices[3 * i + j] = {coordinates[3 * j], coordinates[3 * j + 1], coordinates[3 * j + 2]};
+                mesh.faces[i][j] = 3 * i + j;
+            }
+        }
+    });
+    return mesh;
+}
+
+[[nodiscard]] Mesh read_ascii_stl(const std::string& path, const std::string_view contents) {
+    Mesh mesh;
+    Tokenizer tokenizer(contents);
+    for (std::string_view token = tokenizer.next(); !token.empty(); token = tokenizer.next()) {
+        if (token != "vertex") {
+            continue;
+        }
+        Point vertex;
+        for (size_t i = 0; i < 3; ++i) {
+            const std::optional<double> coordinate = parse_number<double>(tokenizer.next());
+            if (!coordinate) {
+                throw error_at(path, contents, tokenizer.position(), "a vertex needs 3 coordinates");
+            }
+            vertex[i] = *coordinate;
+        }
+        mesh.vertices.push_back(vertex);
+    }
+    if (mesh.vertices.size() % 3 != 0) {
+        throw Exception(path + ": the number of vertices isn't a multiple of 3");
+    }
+    for (size_t i = 0; i < mesh.vertices.size(); i += 3) {
+        mesh.faces.push_back({i, i + 1, i + 2});
+    }
+    return mesh;
+}
+
+// A face of a chunk of an OBJ file. The indices flagged in `relative` are counted from the first vertex of the
+// chunk, since the number of vertices in the preceding chunks isn't known while the chunks are parsed.
+struct ObjFace {
+    std::array<std::int64_t, 3> indices;
+    std::uint8_t relative;
+};
+
+struct ObjChunk {
+    std::vector<Point> vertices;
+    std::vector<ObjFace> faces;
+    // The offset of the first malformed line and the reason.
+    std::optional<std::pair<size_t, std::string>> error;
+};
+
+void parse_obj_chunk(const std::string_view contents, const size_t begin, const size_t end, ObjChunk& chunk) {
+    std::vector<std::pair<std::int64_t, bool>> polygon;
+    for (size_t line_begin = begin; line_begin < end; ) {
+        const size_t line_end = std::min(end, contents.find('\n', line_begin));
+        Tokenizer tokenizer(contents.substr(line_begin, line_end - line_begin));
+        const std::string_view keyword = tokenizer.next();
+        if (keyword == "v") {
+            Point vertex;
+            for (size_t i = 0; i < 3; ++i) {
+                const std::optional<double> coordinate = parse_number<double>(tokenizer.next());
+                if (!coordinate) {
+                    chunk.error.emplace(line_begin, "a vertex needs 3 coordinates");
+                    return;
+                }
+                vertex[i] = *coordinate;
+            }
+            chunk.vertices.push_back(vertex);
+        } else if (keyword == "f") {
+            polygon.clear();
+            for (std::string_view token = tokenizer.next(); !token.empty(); token = tokenizer.next()) {
+                // The texture and normal indices follow the vertex index after slashes.
+                const std::optional<std::int64_t> index = parse_number<std::int64_t>(token.substr(0, token.find('/')));
+                if (!index || *index == 0) {
+                    chunk.error.emplace(line_begin, "invalid vertex index '" + std::string(token) + "'");
+                    return;
+                }
+                if (*index > 0) {
+                    polygon.emplace_back(*index - 1, false);
+                } else {
+                    polygon.emplace_back(static_cast<std::int64_t>(chunk.vertices.size()) + *index, true);
+                }
+            }
+            if (polygon.size() < 3) {
+                chunk.error.emplace(line_begin, "a face needs at least 3 vertices");
+                return;
+            }
+            for (size_t i = 1; i + 1 < polygon.size(); ++i) {
+                ObjFace face{{polygon[0].first, polygon[i].first, polygon[i + 1].first}, 0};
+                face.relative = polygon[0].second | polygon[i].second << 1 | polygon[i + 1].second << 2;
+                chunk.faces.push_back(face);
+            }
+        }
+        line_begin = line_end + 1;
+    }
+}
+
+}
+
+Mesh read_stl(const std::string& path, const size_t threads) {
+    const MappedFile file(path);
+    const std::string_view contents = file.contents();
+
+    // Some binary files start with "solid" too, so the size decides, and a truncated binary file isn't mistaken for
+    // an ASCII one because it contains zero bytes.
+    std::optional<size_t> number_of_facets;
+    if (contents.size() >= stl_header_size + sizeof(std::uint32_t)) {
+        std::uint32_t count;
+        std::memcpy(&count, contents.data() + stl_header_size, sizeof(count));
+        if (contents.size() == stl_header_size + sizeof(count) + count * stl_record_size) {
+            number_of_facets = count;
+        }
+    }
+    Mesh mesh;
+    if (number_of_facets) {
+        mesh = read_binary_stl(contents, *number_of_facets, threads);
+    } else if (contents.substr(0, 5) == "solid" && contents.find('\0') == std::string_view::npos) {
+        mesh = read_ascii_stl(path, contents);
+    } else {
+        throw Exception(path + ": the size of the file doesn't match the number of facets of a binary STL file");
+    }
+    weld_vertices(mesh);
+    return mesh;
+}
+
+Mesh read_obj(const std::string& path, const size_t threads) {
+    const MappedFile file(path);
+    const std::string_view contents = file.contents();
+
+    std::vector<size_t> boundaries{0};
+    const size_t chunk_size = std::max(min_obj_chunk_size, contents.size() / (4 * std::max<size_t>(1, threads)) + 1);
+    while (boundaries.back() < contents.size()) {
+        const size_t line_break = contents.find('\n', boundaries.back() + chunk_size);
+        boundaries.push_back(line_break == std::string_view::npos ? contents.size() : line_break + 1);
+    }
+    std::vector<ObjChunk> chunks(boundaries.size() - 1);
+    parallel_for(chunks.size(), threads, 1, [&](size_t, const size_t begin, const size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            parse_obj_chunk(contents, boundaries[i], boundaries[i + 1], chunks[i]);
+        }
+    });
+
+    Mesh mesh;
+    size_t number_of_faces = 0;
+    for (const ObjChunk& chunk: chunks) {
+        if (chunk.error) {
+            throw error_at(path, contents, chunk.error->first, chunk.error->second);
+        }
+        number_of_faces += chunk.faces.size();
+    }
+    mesh.faces.reserve(number_of_faces);
+    for (const ObjChunk& chunk: chunks) {
+        const auto first_vertex = static_cast<std::int64_t>(mesh.vertices.size());
+        mesh.vertices.insert(mesh.vertices.end(), chunk.vertices.begin(), chunk.vertices.end());
+        for (const ObjFace& face: chunk.faces) {
+            Mesh::Face& resolved = mesh.faces.emplace_back();
+            for (size_t j = 0; j < 3; ++j) {
+                const std::int64_t index = face.indices[j] + (face.relative >> j & 1 ? first_vertex : 0);
+                // The vertices defined after the face are allowed, so the indices are checked in the end.
+                if (index < 0) {
+                    throw Exception(path + ": a relative vertex index precedes the first vertex");
+                }
+                resolved[j] = static_cast<size_t>(index);
+            }
+        }
+    }
+    for (const Mesh::Face& face: mesh.faces) {
+        for (const size_t index: face) {
+            if (index >= mesh.vertices.size()) {
+                throw Exception(path + ": vertex " + std::to_string(index + 1) + " is referenced, but there are " +
+                                std::to_string(mesh.vertices.size()) + " vertices");
+            }
+        }
+    }
+    return mesh;
+}
+
+Mesh read_mesh(const std::string& path, const size_t threads) {
+    const size_t dot = path.rfind('.');
+    std::string extension = dot == std::string::npos ? "" : path.substr(dot + 1);
+    std::transform(extension.begin(), extension.end(), extension.begin(),
+                   [](const unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    if (extension == "stl") {
+        return read_stl(path, threads);
+    }
+    if (extension == "obj") {
+        return read_obj(path, threads);
+    }
+    throw Exception(path + ": unknown mesh format, .stl or .obj is expected");
+}
+
+}
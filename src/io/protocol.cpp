@@ -0,0 +1,83 @@
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "intersection_of_two_triangles/io/protocol.hpp"
+
+namespace intersection_of_two_triangles {
+
+namespace {
+
+// The payload is read in chunks of at least this size, and at most the size already read.
+constexpr size_t min_read_size = 1 << 16;
+
+void write_all(const int descriptor, const char* data, size_t size) {
+    while (size != 0) {
+        // `MSG_NOSIGNAL` turns a write to a closed connection into an error instead of `SIGPIPE`.
+        const ssize_t written = send(descriptor, data, size, MSG_NOSIGNAL);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw Exception(std::string("send failed: ") + std::strerror(errno));
+        }
+        data += written;
+        size -= static_cast<size_t>(written);
+    }
+}
+
+// Returns the number of bytes read, which is less than `size` only at the end of the stream.
+[[nodiscard]] size_t read_all(const int descriptor, char* const data, const size_t size) {
+    size_t done = 0;
+    while (done < size) {
+        const ssize_t count = read(descriptor, data + done, size - done);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw Exception(std::string("read failed: ") + std::strerror(errno));
+        }
+        if (count == 0) {
+            break;
+        }
+        done += static_cast<size_t>(count);
+    }
+    return done;
+}
+
+}
+
+void write_frame(const int descriptor, const std::uint64_t type, const std::string_view payload) {
+    const FrameHeader header{type, payload.size()};
+    write_all(descriptor, reinterpret_cast<const char*>(&header), sizeof(header));
+    write_all(descriptor, payload.data(), payload.size());
+}
+
+std::optional<std::uint64_t> read_frame(const int descriptor, std::string& payload) {
+    FrameHeader header{};
+    const size_t header_size = read_all(descriptor, reinterpret_cast<char*>(&header), sizeof(header));
+    if (header_size == 0) {
+        return std::nullopt;
+    }
+    if (header_size < sizeof(header)) {
+        throw Exception("the connection was closed inside a frame header");
+    }
+    if (header.size > max_frame_size) {
+        throw Exception("the frame of " + std::to_string(header.size) + " bytes is too large");
+    }
+    payload.clear();
+    while (payload.size() < header.size) {
+        const size_t begin = payload.size();
+        const size_t size = std::min<std::uint64_t>(header.size - begin, std::max(begin, min_read_size));
+        payload.resize(begin + size);
+        if (read_all(descriptor, payload.data() + begin, size) < size) {
+            throw Exception("the connection was closed inside a frame");
+        }
+    }
+    return header.type;
+}
+
+}
@@ -0,0 +1,316 @@
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "intersection_of_two_triangles/exception.hpp"
+#include "intersection_of_two_triangles/io/result_cache.hpp"
+
+namespace intersection_of_two_triangles {
+
+struct ResultCache::Header {
+    char magic[8];
+    std::uint64_t format_version;
+    std::uint64_t capacity;
+    std::uint64_t size;
+};
+
+struct ResultCache::Slot {
+    Key key;
+    // One of the `SlotValue`s.
+    std::uint64_t value;
+};
+
+namespace {
+
+constexpr char cache_magic[8] = {'I', '2', 'T', 'C', 'A', 'C', 'H', 'E'};
+// The version of the layout of the file.
+constexpr std::uint64_t format_version = 1;
+constexpr std::uint64_t initial_capacity = 1 << 16;
+// The words hashed into a key: `algorithm_version`, the four settings and the 18 coordinates.
+constexpr size_t key_words = 5 + 18;
+
+enum SlotValue : std::uint64_t {
+    kEmpty,
+    kFalse,
+    kTrue,
+};
+
+[[nodiscard]] std::string system_error(const std::string& path, const char* what) {
+    return "ResultCache: " + path + ": " + what + ": " + std::strerror(errno);
+}
+
+// Makes the renames in the directory of `path` durable.
+void sync_directory(const std::string& path) {
+    const size_t slash = path.rfind('/');
+    const std::string directory = slash == std::string::npos ? "." : slash == 0 ? "/" : path.substr(0, slash);
+    const int descriptor = open(directory.c_str(), O_RDONLY | O_DIRECTORY);
+    if (descriptor < 0) {
+        throw Exception(system_error(directory, "open failed"));
+    }
+    const int status = fsync(descriptor);
+    const int error = errno;
+    close(descriptor);
+    if (status != 0) {
+        errno = error;
+        throw Exception(system_error(directory, "fsync failed"));
+    }
+}
+
+// The coordinates of the vertices in order, which are compared lexicographically.
+[[nodiscard]] std::array<double, 9> coordinates(const std::array<Point, 3>& vertices) {
+    std::array<double, 9> result{};
+    for (size_t i = 0; i < 9; ++i) {
+        result[i] = vertices[i / 3][i % 3];
+    }
+    return result;
+}
+
+[[nodiscard]] std::array<Point, 3> least_rotation(const GeneralTriangle& gt) {
+    std::array<Point, 3> result = gt.vertices;
+    for (size_t i = 1; i < 3; ++i) {
+        const std::array<Point, 3> rotated{gt.vertices[i], gt.vertices[(i + 1) % 3], gt.vertices[(i + 2) % 3]};
+        if (coordinates(rotated) < coordinates(result)) {
+            result = rotated;
+        }
+    }
+    return result;
+}
+
+[[nodiscard]] std::uint64_t bits(const double value) {
+    // Adding zero turns -0 into +0, which compare equal.
+    const double normalized = value + 0.0;
+    std::uint64_t result{};
+    std::memcpy(&result, &normalized, sizeof(result));
+    return result;
+}
+
+[[nodiscard]] std::uint64_t hash(const std::array<std::uint64_t, key_words>& words, std::uint64_t seed) {
+    std::uint64_t result = seed;
+    for (const std::uint64_t word: words) {
+        result = (result ^ word) * 0x9E3779B97F4A7C15;
+        result ^= result >> 29;
+    }
+    // The finalizer of MurmurHash3, so that every bit of the words affects every bit of the result.
+    result ^= result >> 33;
+    result *= 0xFF51AFD7ED558CCD;
+    result ^= result >> 33;
+    result *= 0xC4CEB9FE1A85EC53;
+    result ^= result >> 33;
+    return result;
+}
+
+}
+
+std::array<GeneralTriangle, 2> canonical_pair(const GeneralTriangle& gt1, const GeneralTriangle& gt2) {
+    std::array<GeneralTriangle, 2> result{GeneralTriangle{least_rotation(gt1)}, GeneralTriangle{least_rotation(gt2)}};
+    if (coordinates(result[1].vertices) < coordinates(result[0].vertices)) {
+        std::swap(result[0], result[1]);
+    }
+    return result;
+}
+
+ResultCache::ResultCache(std::string path) : path_(std::move(path)) {
+    const int descriptor = open(path_.c_str(), O_RDWR | O_CREAT, 0644);
+    if (descriptor < 0) {
+        throw Exception(system_error(path_, "open failed"));
+    }
+    if (flock(descriptor, LOCK_EX | LOCK_NB) != 0) {
+        close(descriptor);
+        throw Exception(system_error(path_, "the cache is locked"));
+    }
+    struct stat status{};
+    if (fstat(descriptor, &status) != 0) {
+        close(descriptor);
+        throw Exception(system_error(path_, "stat failed"));
+    }
+
+    if (status.st_size == 0) {
+        map(descriptor, initial_capacity, true);
+        return;
+    }
+    Header header{};
+    if (static_cast<size_t>(status.st_size) < sizeof(Header) ||
+        pread(descriptor, &header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header)) ||
+        std::memcmp(header.magic, cache_magic, sizeof(cache_magic)) != 0 || header.format_version != format_version ||
+        header.capacity == 0 || (header.capacity & (header.capacity - 1)) != 0 ||
+        static_cast<std::uint64_t>(status.st_size) != sizeof(Header) + header.capacity * sizeof(Slot)) {
+        close(descriptor);
+        throw Exception("ResultCache: " + path_ + " isn't a result cache of this format");
+    }
+    map(descriptor, header.capacity, false);
+}
+
+ResultCache::~ResultCache() {
+    unmap();
+}
+
+ResultCache::Key ResultCache::key(const std::array<GeneralTriangle, 2>& canonical_pair, const CacheContext& context) {
+    std::array<std::uint64_t, key_words> words{algorithm_version, bits(context.tolerance.absolute_epsilon),
+                                               bits(context.tolerance.relative_epsilon),
+                                               bits(context.tolerance.coordinate_scale), bits(context.resolution)};
+    size_t i = 5;
+    for (const GeneralTriangle& gt: canonical_pair) {
+        for (const Point& vertex: gt.vertices) {
+            for (size_t j = 0; j < 3; ++j) {
+                words[i++] = bits(vertex[j]);
+            }
+        }
+    }
+    return {hash(words, 0x2545F4914F6CDD1D), hash(words, 0x9FB21C651E98DF25)};
+}
+
+std::optional<bool> ResultCache::find(const Key& key) const {
+    const std::uint64_t mask = header().capacity - 1;
+    const Slot* const slots = this->slots();
+    for (std::uint64_t i = key[0] & mask; slots[i].value != kEmpty; i = (i + 1) & mask) {
+        if (slots[i].key == key) {
+            return slots[i].value == kTrue;
+        }
+    }
+    return std::nullopt;
+}
+
+void ResultCache::insert(const Key& key, const bool answer) {
+    if ((header().size + 1) * 2 > header().capacity) {
+        grow();
+    }
+    insert(data_, key, answer ? kTrue : kFalse);
+}
+
+size_t ResultCache::size() const {
+    return header().size;
+}
+
+size_t ResultCache::capacity() const {
+    return header().capacity;
+}
+
+ResultCache::Header& ResultCache::header() const {
+    return *static_cast<Header*>(data_);
+}
+
+ResultCache::Slot* ResultCache::slots() const {
+    return slots(data_);
+}
+
+ResultCache::Slot* ResultCache::slots(void* const data) {
+    return reinterpret_cast<Slot*>(static_cast<char*>(data) + sizeof(Header));
+}
+
+void ResultCache::insert(void* const data, const Key& key, const std::uint64_t value) {
+    Header& header = *static_cast<Header*>(data);
+    const std::uint64_t mask = header.capacity - 1;
+    Slot* const slots = ResultCache::slots(data);
+    std::uint64_t i = key[0] & mask;
+    for (; slots[i].value != kEmpty && slots[i].key != key; i = (i + 1) & mask) {
+    }
+    if (slots[i].value == kEmpty) {
+        ++header.size;
+    }
+    slots[i] = {key, value};
+}
+
+void ResultCache::map(const int descriptor, const std::uint64_t capacity, const bool initialize) {
+    const size_t bytes = sizeof(Header) + capacity * sizeof(Slot);
+    if (initialize && ftruncate(descriptor, static_cast<off_t>(bytes)) != 0) {
+        close(descriptor);
+        throw Exception(system_error(path_, "resizing failed"));
+    }
+    void* const data = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+    if (data == MAP_FAILED) {
+        close(descriptor);
+        throw Exception(system_error(path_, "mmap failed"));
+    }
+    unmap();
+    descriptor_ = descriptor;
+    data_ = data;
+    bytes_ = bytes;
+    if (initialize) {
+        // The new file is filled with zeros, i.e. empty slots.
+        Header& header = this->header();
+        std::memcpy(header.magic, cache_magic, sizeof(cache_magic));
+        header.format_version = format_version;
+        header.capacity = capacity;
+        header.size = 0;
+    }
+}
+
+void ResultCache::unmap() {
+    if (data_) {
+        munmap(data_, bytes_);
+        data_ = nullptr;
+    }
+    if (descriptor_ >= 0) {
+        close(descriptor_);
+        descriptor_ = -1;
+    }
+}
+
+// Rehashes the slots into a new file, which replaces the old one atomically, so that a crash leaves a valid cache. The
+// new file is flushed to the disk before the rename, so that the path never names a partly written file, and the
+// directory after it, so that the rename itself survives a crash. The old file stays locked until the rename, so no
+// other process can write to it in between, and the cache switches to the new file only after the rename, so it stays
+// on the old one if growing fails.
+void ResultCache::grow() {
+    const std::uint64_t capacity = header().capacity * 2;
+    const size_t bytes = sizeof(Header) + capacity * sizeof(Slot);
+    const std::string temporary_path = path_ + ".tmp";
+    const int descriptor = open(temporary_path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (descriptor < 0) {
+        throw Exception(system_error(temporary_path, "open failed"));
+    }
+    void* data = MAP_FAILED;
+    const auto fail = [&](const std::string& path, const char* const what) {
+        const Exception exception(system_error(path, what));
+        if (data != MAP_FAILED) {
+            munmap(data, bytes);
+        }
+        close(descriptor);
+        unlink(temporary_path.c_str());
+        throw exception;
+    };
+    if (flock(descriptor, LOCK_EX) != 0) {
+        fail(temporary_path, "locking failed");
+    }
+    if (ftruncate(descriptor, static_cast<off_t>(bytes)) != 0) {
+        fail(temporary_path, "resizing failed");
+    }
+    data = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+    if (data == MAP_FAILED) {
+        fail(temporary_path, "mmap failed");
+    }
+
+    // The new file is filled with zeros, i.e. empty slots.
+    Header& new_header = *static_cast<Header*>(data);
+    std::memcpy(new_header.magic, cache_magic, sizeof(cache_magic));
+    new_header.format_version = format_version;
+    new_header.capacity = capacity;
+    new_header.size = 0;
+    std::for_each(slots(), slots() + header().capacity, [data](const Slot& slot) {
+        if (slot.value != kEmpty) {
+            insert(data, slot.key, slot.value);
+        }
+    });
+
+    if (msync(data, bytes, MS_SYNC) != 0 || fsync(descriptor) != 0) {
+        fail(temporary_path, "fsync failed");
+    }
+    if (rename(temporary_path.c_str(), path_.c_str()) != 0) {
+        fail(path_, "rename failed");
+    }
+    // The path names the new file now, so the cache switches to it even if syncing the directory fails.
+    unmap();
+    descriptor_ = descriptor;
+    data_ = data;
+    bytes_ = bytes;
+    sync_directory(path_);
+}
+
+}
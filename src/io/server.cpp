@@ -0,0 +1,270 @@
+#include <array>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <exception>
+#include <limits>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "intersection_of_two_triangles/algorithms/batch_intersection.hpp"
+#include "intersection_of_two_triangles/exception.hpp"
+#include "intersection_of_two_triangles/io/mesh_reader.hpp"
+#include "intersection_of_two_triangles/io/server.hpp"
+#include "intersection_of_two_triangles/primitives/segment.hpp"
+
+namespace intersection_of_two_triangles {
+
+namespace {
+
+[[nodiscard]] Exception system_error(const std::string& what) {
+    return Exception(what + ": " + std::strerror(errno));
+}
+
+[[nodiscard]] sockaddr_un socket_address(const std::string& path) {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path)) {
+        throw Exception(path + ": the socket path is too long");
+    }
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+    return address;
+}
+
+[[nodiscard]] Point read_point(PayloadReader& reader) {
+    const auto x = reader.read<double>();
+    const auto y = reader.read<double>();
+    const auto z = reader.read<double>();
+    return {x, y, z};
+}
+
+[[nodiscard]] GeneralTriangle read_triangle(PayloadReader& reader) {
+    const Point a = read_point(reader);
+    const Point b = read_point(reader);
+    const Point c = read_point(reader);
+    return {a, b, c};
+}
+
+}
+
+Server::Server(std::string socket_path, const Tolerance& tolerance) :
+    socket_path_(std::move(socket_path)), tolerance_(tolerance) {
+    const sockaddr_un address = socket_address(socket_path_);
+    listener_ = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (listener_ < 0) {
+        throw system_error("socket failed");
+    }
+    if (bind(listener_, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+        // The file of a crashed server remains, so it's replaced if nobody accepts connections on it.
+        const int probe = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        const bool is_stale = errno == EADDRINUSE && probe >= 0 &&
+                              connect(probe, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0;
+        if (probe >= 0) {
+            close(probe);
+        }
+        if (!is_stale || unlink(socket_path_.c_str()) != 0 ||
+            bind(listener_, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+            const Exception error = system_error(socket_path_);
+            close(listener_);
+            throw error;
+        }
+    }
+    if (listen(listener_, SOMAXCONN) != 0 || pipe2(wake_, O_CLOEXEC | O_NONBLOCK) != 0) {
+        const Exception error = system_error(socket_path_);
+        close(listener_);
+        unlink(socket_path_.c_str());
+        throw error;
+    }
+}
+
+Server::~Server() {
+    {
+        const std::lock_guard lock(connections_mutex_);
+        reap_connections(true);
+    }
+    unlink(socket_path_.c_str());
+    close(listener_);
+    close(wake_[0]);
+    close(wake_[1]);
+}
+
+void Server::run() {
+    while (true) {
+        std::array<pollfd, 2> descriptors{{{listener_, POLLIN, 0}, {wake_[0], POLLIN, 0}}};
+        if (poll(descriptors.data(), descriptors.size(), -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw system_error("poll failed");
+        }
+        if (descriptors[1].revents != 0) {
+            break;
+        }
+        const int descriptor = accept4(listener_, nullptr, nullptr, SOCK_CLOEXEC);
+        if (descriptor < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) {
+                continue;
+            }
+            throw system_error("accept failed");
+        }
+
+        const std::lock_guard lock(connections_mutex_);
+        Connection& connection = connections_.emplace_back();
+        connection.descriptor = descriptor;
+        connection.thread = std::thread([this, &connection] { serve(connection); });
+        reap_connections(false);
+    }
+    const std::lock_guard lock(connections_mutex_);
+    reap_connections(true);
+}
+
+void Server::stop() {
+    const char byte = 0;
+    [[maybe_unused]] const ssize_t written = write(wake_[1], &byte, 1);
+}
+
+void Server::serve(Connection& connection) {
+    std::string payload;
+    try {
+        while (const std::optional<std::uint64_t> type = read_frame(connection.descriptor, payload)) {
+            Status status = Status::ok;
+            std::string response;
+            try {
+                response = answer(*type, payload);
+            } catch (const Exception& e) {
+                status = Status::error;
+                response = e.what();
+            } catch (const std::bad_alloc&) {
+                status = Status::error;
+                response = "out of memory";
+            } catch (const std::exception& e) {
+                status = Status::error;
+                response = e.what();
+            }
+            if (response.size() > max_frame_size) {
+                status = Status::error;
+                response = "the response of " + std::to_string(response.size()) + " bytes is too large";
+            }
+            write_frame(connection.descriptor, static_cast<std::uint64_t>(status), response);
+        }
+    } catch (const std::exception&) {
+        // A broken frame or connection, or running out of memory for it, ends only this connection.
+    }
+    // The socket is closed when the thread is joined, but the client must see the end of the connection now.
+    shutdown(connection.descriptor, SHUT_RDWR);
+    connection.finished = true;
+}
+
+std::string Server::answer(const std::uint64_t type, const std::string_view payload) {
+    PayloadReader reader(payload);
+    std::string response;
+    switch (static_cast<Request>(type)) {
+        case Request::upload_mesh: {
+            std::vector<GeneralTriangle> triangles(reader.read_count(9 * sizeof(double)));
+            for (GeneralTriangle& triangle: triangles) {
+                triangle = read_triangle(reader);
+            }
+            append(response, add_mesh(std::make_shared<const MeshIndex>(std::move(triangles), tolerance_)));
+            break;
+        }
+        case Request::load_mesh_file: {
+            const Mesh mesh = read_mesh(std::string(reader.rest()), 1);
+            append(response, add_mesh(std::make_shared<const MeshIndex>(mesh.triangles(), tolerance_)));
+            break;
+        }
+        case Request::drop_mesh: {
+            const auto id = reader.read<MeshId>();
+            const std::lock_guard lock(meshes_mutex_);
+            if (meshes_.erase(id) == 0) {
+                throw Exception("unknown mesh " + std::to_string(id));
+            }
+            break;
+        }
+        case Request::check_pairs: {
+            std::vector<TrianglePair> pairs(reader.read_count(18 * sizeof(double)));
+            for (TrianglePair& pair: pairs) {
+                pair[0] = read_triangle(reader);
+                pair[1] = read_triangle(reader);
+            }
+            const std::vector<bool> answers = are_intersecting_batch(pairs, tolerance_);
+            response.reserve(answers.size());
+            for (const bool answer: answers) {
+                response.push_back(static_cast<char>(answer));
+            }
+            break;
+        }
+        case Request::intersect_meshes: {
+            const std::shared_ptr<const MeshIndex> first = mesh(reader.read<MeshId>());
+            const std::shared_ptr<const MeshIndex> second = mesh(reader.read<MeshId>());
+            const std::vector<std::pair<size_t, size_t>> pairs = first->intersect(*second);
+            append(response, std::uint64_t{pairs.size()});
+            for (const auto& [a, b]: pairs) {
+                append(response, std::uint64_t{a});
+                append(response, std::uint64_t{b});
+            }
+            break;
+        }
+        case Request::intersect_segments: {
+            const std::shared_ptr<const MeshIndex> index = mesh(reader.read<MeshId>());
+            const std::uint64_t count = reader.read_count(6 * sizeof(double));
+            std::vector<Segment> segments;
+            segments.reserve(count);
+            while (segments.size() < count) {
+                const Point a = read_point(reader);
+                const Point b = read_point(reader);
+                segments.emplace_back(a, b, tolerance_);
+            }
+            const std::vector<MeshHit> hits = index->intersect(segments);
+            append(response, std::uint64_t{hits.size()});
+            for (const MeshHit& hit: hits) {
+                append(response, std::uint64_t{hit.query});
+                append(response, std::uint64_t{hit.triangle});
+                append(response, hit.parameter.value_or(std::numeric_limits<double>::quiet_NaN()));
+            }
+            break;
+        }
+        default:
+            throw Exception("unknown request " + std::to_string(type));
+    }
+    return response;
+}
+
+std::shared_ptr<const MeshIndex> Server::mesh(const MeshId id) const {
+    const std::shared_lock lock(meshes_mutex_);
+    const auto it = meshes_.find(id);
+    if (it == meshes_.end()) {
+        throw Exception("unknown mesh " + std::to_string(id));
+    }
+    return it->second;
+}
+
+MeshId Server::add_mesh(std::shared_ptr<const MeshIndex> index) {
+    const std::lock_guard lock(meshes_mutex_);
+    const MeshId id = next_mesh_id_++;
+    meshes_.emplace(id, std::move(index));
+    return id;
+}
+
+void Server::reap_connections(const bool all) {
+    for (auto it = connections_.begin(); it != connections_.end(); ) {
+        if (!all && !it->finished) {
+            ++it;
+            continue;
+        }
+        // The blocked reads of the connections still open return once the socket is shut down.
+        shutdown(it->descriptor, SHUT_RDWR);
+        it->thread.join();
+        close(it->descriptor);
+        it = connections_.erase(it);
+    }
+}
+
+}
@@ -0,0 +1,151 @@
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <ios>
+#include <string_view>
+
+#include "intersection_of_two_triangles/exception.hpp"
+#include "intersection_of_two_triangles/io/test_file_reader.hpp"
+
+namespace intersection_of_two_triangles {
+
+namespace {
+
+// Returns `std::nullopt` if the line isn't a line with an expected answer.
+[[nodiscard]] std::optional<bool> parse_expected_answer(const std::string_view line) {
+    if (!line.empty() && line[0] == '#') {
+        return std::nullopt;
+    }
+    if (line.find("false") != std::string_view::npos) {
+        return false;
+    }
+    if (line.find("true") != std::string_view::npos) {
+        return true;
+    }
+    return std::nullopt;
+}
+
+}
+
+ParseError::ParseError(const size_t line_index, const std::string& reason) :
+    Exception("line " + std::to_string(line_index) + ": " + reason), line_index_(line_index), reason_(reason) {}
+
+size_t ParseError::line_index() const {
+    return line_index_;
+}
+
+const std::string& ParseError::reason() const {
+    return reason_;
+}
+
+TestFileReader::TestFileReader(std::istream& in, const size_t first_line_index, const std::uint64_t length) :
+    in_(in), line_index_(first_line_index - 1), bytes_left_(length) {
+    input_.reserve(18);
+}
+
+std::optional<TestCase> TestFileReader::next() {
+    while (bytes_left_ != 0 && std::getline(in_, line_)) {
+        ++line_index_;
+        bytes_left_ -= std::min<std::uint64_t>(bytes_left_, line_.size() + 1);
+        if (!line_.empty() && line_[0] == '#') {
+            continue;
+        }
+        const std::optional<bool> expected_answer = parse_expected_answer(line_);
+        if (!expected_answer) {
+            parse_numbers();
+            continue;
+        }
+        if (input_.size() != 18) {
+            throw ParseError(line_index_, "two triangles are expected before the answer");
+        }
+        const auto& in = input_;
+        TestCase result{line_index_,
+                        {GeneralTriangle{Point(in[0], in[1], in[2]),
+                                         Point(in[3], in[4], in[5]),
+                                         Point(in[6], in[7], in[8])},
+                         GeneralTriangle{Point(in[9], in[10], in[11]),
+                                         Point(in[12], in[13], in[14]),
+                                         Point(in[15], in[16], in[17])}},
+                        *expected_answer};
+        input_.clear();
+        return result;
+    }
+
+    return std::nullopt;
+}
+
+void TestFileReader::parse_numbers() {
+    const size_t initial_size = input_.size();
+    const char* begin{};
+    char* end = line_.data();
+    for (; ; ) {
+        begin = end;
+        errno = 0;
+        const double parsed = std::strtod(begin, &end);
+        if (begin == end) {
+            break;
+        }
+        if (errno == ERANGE) {
+            errno = 0;
+            throw ParseError(line_index_,
+                             "a range error occurred for " + std::string(begin, static_cast<const char*>(end)));
+        }
+        input_.push_back(parsed);
+    }
+    if (input_.size() == initial_size) {
+        return;
+    }
+    if (input_.size() % 3 != 0 || input_.size() > 18) {
+        throw ParseError(line_index_, "unexpected number of coordinates");
+    }
+    const size_t start = (input_.size() <= 9 ? 0 : 9);
+    while (input_.size() < start + 9) {
+        input_.insert(input_.end(), input_.begin() + start, input_.begin() + start + 3);
+    }
+}
+
+size_t TestFileReader::line_index() const {
+    return line_index_;
+}
+
+std::vector<ByteRange> split_into_ranges(std::istream& in, const size_t count) {
+    in.seekg(0, std::ios::end);
+    const std::streamoff size = in.tellg();
+    std::vector<ByteRange> result;
+    if (size <= 0 || count == 0) {
+        return result;
+    }
+    const auto total = static_cast<std::uint64_t>(size);
+
+    std::string line;
+    std::uint64_t begin = 0;
+    for (size_t i = 1; i < count && begin < total; ++i) {
+        // The target is `total * i / count` without the overflow. The line containing the byte before the target
+        // is skipped, since it may start before the target, then the range is extended up to the next answer.
+        std::uint64_t position = std::max(begin, total / count * i + total % count * i / count);
+        in.clear();
+        if (position != 0) {
+            in.seekg(static_cast<std::streamoff>(position - 1));
+            std::getline(in, line);
+            position += line.size();
+        }
+        std::uint64_t end = total;
+        while (position < total && std::getline(in, line)) {
+            position += line.size() + 1;
+            if (parse_expected_answer(line)) {
+                end = std::min(position, total);
+                break;
+            }
+        }
+        result.push_back({begin, end});
+        begin = end;
+    }
+    if (begin < total) {
+        result.push_back({begin, total});
+    }
+    in.clear();
+    in.seekg(0);
+    return result;
+}
+
+}
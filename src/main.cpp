@@ -1,95 +1,669 @@
-#include <cassert>
-#include <cerrno>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <csignal>
+#include <cstdint>
 #include <cstdlib>
-#include <cstring>
 #include <fstream>
+#include <functional>
+#include <iomanip>
 #include <ios>
 #include <iostream>
+#include <map>
 #include <optional>
 #include <ostream>
+#include <sstream>
 #include <string>
 #include <string_view>
+#include <thread>
+#include <utility>
 #include <vector>
 
 #include "intersection_of_two_triangles/algorithms/are_intersecting.hpp"
-#include "intersection_of_two_triangles/primitives/general_triangle.hpp"
-#include "intersection_of_two_triangles/primitives/point.hpp"
+#include "intersection_of_two_triangles/algorithms/exact_predicates.hpp"
+#include "intersection_of_two_triangles/algorithms/uniform_grid.hpp"
+#include "intersection_of_two_triangles/exception.hpp"
+#include "intersection_of_two_triangles/io/mesh_reader.hpp"
+#include "intersection_of_two_triangles/io/result_cache.hpp"
+#include "intersection_of_two_triangles/io/server.hpp"
+#include "intersection_of_two_triangles/io/test_file_reader.hpp"
+#include "intersection_of_two_triangles/primitives/quantized_triangle.hpp"
+#include "intersection_of_two_triangles/profiling/code_path.hpp"
+#include "intersection_of_two_triangles/profiling/latency_histogram.hpp"
+#include "intersection_of_two_triangles/profiling/performance_counters.hpp"
+#include "intersection_of_two_triangles/utility/bounded_queue.hpp"
+#include "intersection_of_two_triangles/utility/parallel_for.hpp"
+#include "intersection_of_two_triangles/utility/worker_processes.hpp"
 
-int main(const int argc, const char* const* const argv) {
-    const bool test_implementations = argc >= 2 && !std::strcmp(argv[1], "--test-implementations");
+namespace {
 
-    if (argc <= 1 + test_implementations) {
-        std::cerr << "A test file must be provided as a command line argument. "
-                  << "Example: intersection_of_two_triangles ./tests.txt" << std::endl;
-        return 1;
-    }
+using namespace intersection_of_two_triangles;
 
-    std::cout << std::boolalpha;
+constexpr std::string_view usage =
+    "Usage: intersection_of_two_triangles [options] test_file...\n"
+    "       intersection_of_two_triangles [options] --mesh <file> [--mesh <file>]\n"
+    "       intersection_of_two_triangles [options] --serve <socket>\n"
+    "Options:\n"
+    "  --absolute-epsilon <value>  the absolute epsilon of the comparisons of numbers\n"
+    "  --relative-epsilon <value>  the relative epsilon of the comparisons of numbers, less than 1\n"
+    "  --tolerance-scale <value>   derive the epsilons for coordinates of the given magnitude; the epsilons given\n"
+    "                              explicitly replace the derived ones\n"
+    "  --quantize <resolution>     snap the vertices to the lattice with the given step and check the triangles\n"
+    "                              with exact integer predicates\n"
+    "  --timing                    measure every check and report the latency percentiles and the slowest pairs\n"
+    "  --perf-counters             count cycles, instructions, branch and cache misses of every check and report\n"
+    "                              them per code path\n"
+    "  --shards <count>            split every file into this many parts, up to 1024, and check them in worker\n"
+    "                              processes\n"
+    "  --pipeline                  read, check and report the tests in overlapping stages on several threads\n"
+    "  --cache <path>              reuse the answers stored in the cache file and store the new ones there\n"
+    "  --mesh <file>               find the self-intersections of an STL or OBJ mesh, or the intersections of two\n"
+    "                              meshes if given twice\n"
+    "  --weld <distance>           merge the vertices of the meshes closer than the distance before the check\n"
+    "  --serve <socket>            answer the requests of clients on the Unix domain socket until interrupted\n";
+
+constexpr size_t number_of_slowest_pairs = 10;
+constexpr size_t number_of_printed_mesh_pairs = 10;
+// Bounds the number of worker processes, which is checked before the conversion from the parsed double.
+constexpr size_t max_shards = 1024;
 
-    for (int i = 1 + test_implementations; i < argc; ++i) {
-        std::ifstream in(argv[i]);
-        std::string line;
-        std::vector<double> input;
-        input.reserve(18);
-        size_t total_number_of_tests = 0;
-        size_t number_of_failed_tests = 0;
-        for (size_t line_index = 1; std::getline(in, line); ++line_index) {
-            if (line[0] == '#') {
-                continue;
+struct Options {
+    Tolerance tolerance;
+    std::optional<Quantizer> quantizer;
+    bool timing = false;
+    bool perf_counters = false;
+    size_t shards = 1;
+    bool pipeline = false;
+    const char* cache_path = nullptr;
+    std::vector<const char*> meshes;
+    const char* socket_path = nullptr;
+    double weld_distance = 0;
+    std::vector<const char*> files;
+};
+
+[[nodiscard]] std::optional<double> parse_positive_number(const char* const text) {
+    char* end{};
+    const double result = std::strtod(text, &end);
+    if (end == text || *end != '\0' || !(result > 0) || !std::isfinite(result)) {
+        return std::nullopt;
+    }
+    return result;
+}
+
+// Prints the reason to `std::cerr` and returns `std::nullopt` if the arguments are invalid.
+[[nodiscard]] std::optional<Options> parse_options(const int argc, const char* const* const argv) {
+    Options options;
+    // The tolerance options are applied after all of them are read, so that their order doesn't matter.
+    std::optional<double> absolute_epsilon;
+    std::optional<double> relative_epsilon;
+    std::optional<double> tolerance_scale;
+    int i = 1;
+    for (; i < argc && std::string_view(argv[i]).substr(0, 2) == "--"; ++i) {
+        const std::string_view option = argv[i];
+        const auto number = [&]() {
+            const std::optional<double> result = i + 1 < argc ? parse_positive_number(argv[++i]) : std::nullopt;
+            if (!result) {
+                std::cerr << "The option " << option << " requires a positive number\n" << usage;
+            }
+            return result;
+        };
+        if (option == "--test-implementations") {
+            continue;
+        }
+        if (option == "--timing") {
+            options.timing = true;
+            continue;
+        }
+        if (option == "--perf-counters") {
+            options.perf_counters = true;
+            continue;
+        }
+        if (option == "--pipeline") {
+            options.pipeline = true;
+            continue;
+        }
+        if (option == "--cache" || option == "--mesh" || option == "--serve") {
+            if (i + 1 == argc) {
+                std::cerr << "The option " << option << " requires a path\n" << usage;
+                return std::nullopt;
             }
-            std::optional<bool> expected_answer;
-            if (line.find("false") != std::string::npos) {
-                expected_answer = false;
-            } else if (line.find("true") != std::string::npos) {
-                expected_answer = true;
+            if (option == "--cache") {
+                options.cache_path = argv[++i];
+            } else if (option == "--serve") {
+                options.socket_path = argv[++i];
+            } else {
+                options.meshes.push_back(argv[++i]);
             }
-            if (expected_answer) {
-                ++total_number_of_tests;
-                assert(input.size() == 18);
-                using namespace intersection_of_two_triangles;
-                //std::cout << "Running test " << total_number_of_tests << std::endl;
-                const bool result = are_intersecting(
-                    GeneralTriangle{
-                        Point(input[0], input[1], input[2]),
-                        Point(input[3], input[4], input[5]),
-                        Point(input[6], input[7], input[8])},
-                    GeneralTriangle{
-                        Point(input[9], input[10], input[11]),
-                        Point(input[12], input[13], input[14]),
-                        Point(input[15], input[16], input[17])});
-                if (*expected_answer != result) {
-                    std::cout << "line " << line_index << ": expected " << *expected_answer << ", got " << result
-                              << '\n';
-                    ++number_of_failed_tests;
+            continue;
+        }
+        if (option == "--absolute-epsilon" || option == "--relative-epsilon" || option == "--tolerance-scale" ||
+            option == "--quantize" || option == "--shards" || option == "--weld") {
+            const std::optional<double> value = number();
+            if (!value) {
+                return std::nullopt;
+            }
+            if (option == "--absolute-epsilon") {
+                absolute_epsilon = value;
+            } else if (option == "--relative-epsilon") {
+                relative_epsilon = value;
+            } else if (option == "--tolerance-scale") {
+                tolerance_scale = value;
+            } else if (option == "--shards") {
+                if (*value != std::floor(*value) || *value > max_shards) {
+                    std::cerr << "The option --shards requires an integer up to " << max_shards << '\n' << usage;
+                    return std::nullopt;
                 }
-                input.clear();
-                continue;
+                options.shards = static_cast<size_t>(*value);
+            } else if (option == "--weld") {
+                options.weld_distance = *value;
+            } else {
+                options.quantizer.emplace(*value);
             }
-            const char* begin{};
-            char* end = line.data();
-            for (; ; ) {
-                begin = end;
-                const double parsed = std::strtod(begin, &end);
-                if (begin != end) {
-                    input.push_back(parsed);
-                } else {
+            continue;
+        }
+        std::cerr << "Unknown option " << option << '\n' << usage;
+        return std::nullopt;
+    }
+
+    try {
+        // The explicit epsilons replace the ones derived for the scale.
+        const Tolerance scaled = Tolerance::for_scale(tolerance_scale.value_or(1));
+        options.tolerance = Tolerance::make(absolute_epsilon.value_or(scaled.absolute_epsilon),
+                                            relative_epsilon.value_or(scaled.relative_epsilon), scaled.coordinate_scale);
+    } catch (const Exception& e) {
+        std::cerr << e.what() << '\n' << usage;
+        return std::nullopt;
+    }
+    if ((options.shards > 1 || options.pipeline) && (options.timing || options.perf_counters)) {
+        std::cerr << "The options --shards and --pipeline can't be combined with --timing and --perf-counters\n"
+                  << usage;
+        return std::nullopt;
+    }
+    if (options.shards > 1 && options.pipeline) {
+        std::cerr << "The options --shards and --pipeline can't be combined\n" << usage;
+        return std::nullopt;
+    }
+    if ((options.shards > 1 || options.pipeline) && options.cache_path) {
+        std::cerr << "The option --cache can't be combined with --shards and --pipeline\n" << usage;
+        return std::nullopt;
+    }
+    if (options.socket_path) {
+        if (argc > i || !options.meshes.empty() || options.weld_distance != 0 || options.shards > 1 ||
+            options.pipeline || options.cache_path || options.quantizer || options.timing || options.perf_counters) {
+            std::cerr << "The option --serve can be combined only with the tolerance options\n" << usage;
+            return std::nullopt;
+        }
+        return options;
+    }
+    if (!options.meshes.empty()) {
+        if (options.meshes.size() > 2) {
+            std::cerr << "The option --mesh can be given at most twice\n" << usage;
+            return std::nullopt;
+        }
+        if (argc > i || options.shards > 1 || options.pipeline || options.cache_path || options.quantizer ||
+            options.timing || options.perf_counters) {
+            std::cerr << "The option --mesh can be combined only with the tolerance options and --weld\n" << usage;
+            return std::nullopt;
+        }
+        return options;
+    }
+    if (options.weld_distance != 0) {
+        std::cerr << "The option --weld requires --mesh\n" << usage;
+        return std::nullopt;
+    }
+    if (argc <= i) {
+        std::cerr << "A test file must be provided as a command line argument. "
+                  << "Example: intersection_of_two_triangles ./tests.txt" << std::endl;
+        return std::nullopt;
+    }
+    options.files.assign(argv + i, argv + argc);
+    return options;
+}
+
+void print_duration(std::ostream& out, const std::uint64_t nanoseconds) {
+    const auto flags = out.flags();
+    const auto precision = out.precision();
+    out << std::fixed << std::setprecision(2) << nanoseconds / 1000.0 << " us";
+    out.flags(flags);
+    out.precision(precision);
+}
+
+void print_latencies(const LatencyHistogram& histogram, const SlowestSamples& slowest) {
+    std::cout << "Latency of " << histogram.count() << " checks:";
+    for (const auto& [name, percent]: {std::pair("50", 50.0), {"90", 90.0}, {"99", 99.0}, {"99.9", 99.9}}) {
+        std::cout << " p" << name << ' ';
+        print_duration(std::cout, histogram.percentile(percent));
+        std::cout << ',';
+    }
+    std::cout << " max ";
+    print_duration(std::cout, histogram.max());
+    std::cout << "\nSlowest pairs:\n";
+    for (const auto& [nanoseconds, line_index]: slowest.sorted()) {
+        std::cout << "  line " << line_index << ": ";
+        print_duration(std::cout, nanoseconds);
+        std::cout << '\n';
+    }
+}
+
+struct Summary {
+    size_t number_of_tests = 0;
+    size_t number_of_failed_tests = 0;
+    size_t number_of_unquantized_tests = 0;
+    size_t number_of_cache_hits = 0;
+};
+
+struct Profile {
+    LatencyHistogram latencies;
+    SlowestSamples slowest_pairs{number_of_slowest_pairs};
+    PerformanceCountersReport counters_report;
+};
+
+[[nodiscard]] bool check(const TestCase& test, const Options& options, size_t& number_of_unquantized_tests) {
+    if (options.quantizer) {
+        try {
+            return are_intersecting(options.quantizer->quantize(test.triangles[0]),
+                                    options.quantizer->quantize(test.triangles[1]));
+        } catch (const Exception&) {
+            ++number_of_unquantized_tests;
+        }
+    }
+    return are_intersecting(test.triangles[0], test.triangles[1], options.tolerance);
+}
+
+// Checks the test cases of `reader`, counting them in `summary`, and calls `on_failure(test, result)` for the failed
+// ones. With a cache, the canonical pairs are checked and are the keys, so the rotated and swapped variants of a pair get
+// the same answer whichever of them is checked first. Throws `ParseError` if the input is malformed.
+template<class OnFailure>
+void check_tests(TestFileReader& reader, const Options& options, const PerformanceCounters* const counters,
+                 ResultCache* const cache, Summary& summary, Profile& profile, OnFailure&& on_failure) {
+    const CacheContext cache_context{options.tolerance, options.quantizer ? options.quantizer->resolution() : 0};
+    const auto evaluate = [&](const TestCase& test) {
+        if (!cache) {
+            return check(test, options, summary.number_of_unquantized_tests);
+        }
+        TestCase canonical_test = test;
+        canonical_test.triangles = canonical_pair(test.triangles[0], test.triangles[1]);
+        const ResultCache::Key key = ResultCache::key(canonical_test.triangles, cache_context);
+        if (const std::optional<bool> answer = cache->find(key)) {
+            ++summary.number_of_cache_hits;
+            return *answer;
+        }
+        const bool result = check(canonical_test, options, summary.number_of_unquantized_tests);
+        cache->insert(key, result);
+        return result;
+    };
+    while (const auto test = reader.next()) {
+        ++summary.number_of_tests;
+        const CounterValues counters_before = counters ? counters->read() : CounterValues{};
+        bool result{};
+        if (options.timing) {
+            const auto start = std::chrono::steady_clock::now();
+            result = evaluate(*test);
+            const auto nanoseconds = static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start)
+                    .count());
+            profile.latencies.record(nanoseconds);
+            profile.slowest_pairs.record(nanoseconds, test->line_index);
+        } else {
+            result = evaluate(*test);
+        }
+        if (counters) {
+            profile.counters_report.add(code_path(test->triangles[0], test->triangles[1], options.tolerance),
+                                        counters_before, counters->read());
+        }
+        if (test->expected_answer != result) {
+            ++summary.number_of_failed_tests;
+            on_failure(*test, result);
+        }
+    }
+}
+
+void print_failure(const size_t line_index, const bool expected_answer) {
+    std::cout << "line " << line_index << ": expected " << expected_answer << ", got " << !expected_answer << '\n';
+}
+
+void print_summary(const Summary& summary) {
+    if (summary.number_of_unquantized_tests) {
+        std::cout << summary.number_of_unquantized_tests << " tests are out of the lattice bounds and were checked "
+                  << "in floating point\n";
+    }
+    std::cout << "Tests done " << summary.number_of_tests << '/' << summary.number_of_failed_tests << " failed\n";
+}
+
+// A batch of test cases passed between the stages of the pipeline.
+struct Batch {
+    size_t index = 0;
+    std::vector<TestCase> tests;
+    // The results of the first tests; there are fewer of them than tests if checking one has thrown `error`.
+    std::vector<char> results;
+    size_t number_of_unquantized_tests = 0;
+    std::optional<std::string> error;
+};
+
+constexpr size_t pipeline_batch_size = 1024;
+// The number of batches each queue holds. It bounds the memory, since the reader waits when the workers are behind.
+constexpr size_t pipeline_queue_capacity = 64;
+
+// Checks the file in three overlapping stages: a thread reads and parses batches of test cases, worker threads check
+// them, and this thread prints the failures in the input order, reordering the batches finished out of order. The
+// stages are connected by bounded queues. Prints the same report as `check_tests`. Returns false after printing
+// an error.
+[[nodiscard]] bool check_in_pipeline(const char* const file, const Options& options) {
+    BoundedQueue<Batch> parsed(pipeline_queue_capacity);
+    BoundedQueue<Batch> checked(pipeline_queue_capacity);
+    std::atomic<bool> stop{false};
+    Summary summary;
+    std::optional<std::string> read_error;
+
+    std::thread reader_thread([&]() {
+        std::ifstream in(file);
+        TestFileReader reader(in);
+        Batch batch;
+        try {
+            while (!stop.load(std::memory_order_relaxed)) {
+                std::optional<TestCase> test = reader.next();
+                if (test) {
+                    ++summary.number_of_tests;
+                    batch.tests.push_back(*test);
+                }
+                if (!test || batch.tests.size() == pipeline_batch_size) {
+                    const size_t index = batch.index;
+                    parsed.push(std::move(batch));
+                    batch = Batch{};
+                    batch.index = index + 1;
+                }
+                if (!test) {
                     break;
                 }
-                if (errno == ERANGE) {
-                    std::cerr << "A range error occurred for " << std::string_view(begin, *end) << '\n';
-                    errno = 0;
-                    return 1;
+            }
+        } catch (const Exception& e) {
+            read_error = e.what();
+            parsed.push(std::move(batch));
+        }
+        parsed.close();
+    });
+
+    const size_t number_of_workers = default_number_of_threads();
+    std::atomic<size_t> running_workers{number_of_workers};
+    std::vector<std::thread> workers;
+    for (size_t i = 0; i < number_of_workers; ++i) {
+        workers.emplace_back([&]() {
+            while (std::optional<Batch> batch = parsed.pop()) {
+                try {
+                    for (const TestCase& test: batch->tests) {
+                        if (stop.load(std::memory_order_relaxed)) {
+                            break;
+                        }
+                        batch->results.push_back(check(test, options, batch->number_of_unquantized_tests));
+                    }
+                } catch (const Exception& e) {
+                    batch->error = e.what();
                 }
+                checked.push(std::move(*batch));
+            }
+            if (running_workers.fetch_sub(1) == 1) {
+                checked.close();
             }
-            if (input.empty()) {
-                continue;
+        });
+    }
+
+    std::map<size_t, Batch> finished;
+    size_t next_index = 0;
+    std::optional<std::string> error;
+    while (std::optional<Batch> batch = checked.pop()) {
+        if (error) {
+            continue;
+        }
+        finished.emplace(batch->index, std::move(*batch));
+        for (auto it = finished.begin(); it != finished.end() && it->first == next_index;
+             it = finished.erase(it), ++next_index) {
+            const Batch& current = it->second;
+            for (size_t i = 0; i < current.results.size(); ++i) {
+                if (current.tests[i].expected_answer != static_cast<bool>(current.results[i])) {
+                    ++summary.number_of_failed_tests;
+                    print_failure(current.tests[i].line_index, current.tests[i].expected_answer);
+                }
             }
-            assert(input.size() % 3 == 0 && input.size() <= 18);
-            const size_t start = (input.size() <= 9 ? 0 : 9);
-            while (input.size() < start + 9) {
-                input.insert(input.end(), input.begin() + start, input.begin() + start + 3);
+            summary.number_of_unquantized_tests += current.number_of_unquantized_tests;
+            if (current.error) {
+                error = current.error;
+                stop = true;
+                break;
             }
         }
-        std::cout << "Tests done " << total_number_of_tests << '/' << number_of_failed_tests << " failed\n";
+    }
+    reader_thread.join();
+    for (std::thread& worker: workers) {
+        worker.join();
+    }
+
+    if (!error) {
+        error = read_error;
+    }
+    if (error) {
+        std::cerr << file << ": " << *error << '\n';
+        return false;
+    }
+    print_summary(summary);
+    return true;
+}
+
+// Splits the file into `options.shards` byte ranges, checks them in worker processes and prints the same report as
+// checking the file in this process. Each worker sends back the failed tests and the errors with the line indices
+// relative to its range, followed by its counts and the number of lines in the range, which is used to offset the
+// line indices of the next ranges. Returns false after printing an error.
+[[nodiscard]] bool check_in_shards(const char* const file, const Options& options) {
+    std::vector<ByteRange> ranges;
+    {
+        std::ifstream in(file);
+        ranges = split_into_ranges(in, options.shards);
+    }
+
+    // The outputs are printed as soon as the previous ones are, and the ones after a parse error are ignored.
+    Summary summary;
+    size_t line_offset = 0;
+    std::optional<std::string> parse_error;
+    const auto consume = [&](size_t, const std::string& output) {
+        std::istringstream in(output);
+        for (std::string record; !parse_error && in >> record; ) {
+            size_t line_index{};
+            if (record == "failed") {
+                bool expected_answer{};
+                in >> line_index >> expected_answer;
+                print_failure(line_offset + line_index, expected_answer);
+            } else if (record == "error") {
+                std::string reason;
+                in >> line_index >> std::ws;
+                std::getline(in, reason);
+                parse_error = ParseError(line_offset + line_index, reason).what();
+            } else {
+                Summary part;
+                in >> part.number_of_tests >> part.number_of_failed_tests >> part.number_of_unquantized_tests
+                   >> line_index;
+                summary.number_of_tests += part.number_of_tests;
+                summary.number_of_failed_tests += part.number_of_failed_tests;
+                summary.number_of_unquantized_tests += part.number_of_unquantized_tests;
+                line_offset += line_index;
+            }
+        }
+    };
+    try {
+        run_in_worker_processes(ranges.size(), [&](const size_t index) {
+            std::ifstream in(file);
+            in.seekg(static_cast<std::streamoff>(ranges[index].begin));
+            TestFileReader reader(in, 1, ranges[index].end - ranges[index].begin);
+            Summary summary;
+            Profile profile;
+            std::ostringstream out;
+            try {
+                check_tests(reader, options, nullptr, nullptr, summary, profile, [&](const TestCase& test, bool) {
+                    out << "failed " << test.line_index << ' ' << test.expected_answer << '\n';
+                });
+            } catch (const ParseError& e) {
+                out << "error " << e.line_index() << ' ' << e.reason() << '\n';
+            }
+            out << "done " << summary.number_of_tests << ' ' << summary.number_of_failed_tests << ' '
+                << summary.number_of_unquantized_tests << ' ' << reader.line_index() << '\n';
+            return out.str();
+        }, consume);
+    } catch (const Exception& e) {
+        std::cerr << file << ": " << e.what() << '\n';
+        return false;
+    }
+    if (parse_error) {
+        std::cerr << file << ": " << *parse_error << '\n';
+        return false;
+    }
+    print_summary(summary);
+    return true;
+}
+
+// Loads the meshes and prints the intersecting pairs of their faces: of the faces of one mesh which don't share
+// a vertex, or of the faces of the first mesh and the second one. The faces sharing a vertex always touch there, so
+// they aren't reported even if they overlap elsewhere. Returns false after printing an error.
+[[nodiscard]] bool check_meshes(const Options& options) {
+    std::vector<Mesh> meshes;
+    for (const char* const file: options.meshes) {
+        const auto start = std::chrono::steady_clock::now();
+        try {
+            meshes.push_back(read_mesh(file));
+        } catch (const Exception& e) {
+            std::cerr << e.what() << '\n';
+            return false;
+        }
+        if (options.weld_distance != 0) {
+            weld_vertices(meshes.back(), options.weld_distance);
+        }
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        std::cout << file << ": " << meshes.back().vertices.size() << " vertices, " << meshes.back().faces.size()
+                  << " faces, loaded in " << std::chrono::duration<double, std::milli>(elapsed).count() << " ms\n";
+    }
+
+    std::vector<GeneralTriangle> triangles = meshes[0].triangles();
+    const size_t first_mesh_size = triangles.size();
+    std::function<bool(size_t, size_t)> filter;
+    if (meshes.size() == 1) {
+        filter = [&](const size_t a, const size_t b) { return !meshes[0].are_adjacent(a, b); };
+    } else {
+        const std::vector<GeneralTriangle> second = meshes[1].triangles();
+        triangles.insert(triangles.end(), second.begin(), second.end());
+        filter = [&](const size_t a, const size_t b) { return a < first_mesh_size && first_mesh_size <= b; };
+    }
+    const std::vector<std::pair<size_t, size_t>> pairs =
+        find_intersecting_pairs(triangles, options.tolerance, default_number_of_threads(), filter);
+
+    std::cout << "Intersecting pairs of faces: " << pairs.size() << '\n';
+    for (size_t i = 0; i < std::min(pairs.size(), number_of_printed_mesh_pairs); ++i) {
+        const size_t second = meshes.size() == 1 ? pairs[i].second : pairs[i].second - first_mesh_size;
+        std::cout << "  " << pairs[i].first << ' ' << second << '\n';
+    }
+    if (pairs.size() > number_of_printed_mesh_pairs) {
+        std::cout << "  ...\n";
+    }
+    return true;
+}
+
+// The server to stop on `SIGINT` and `SIGTERM`.
+std::atomic<Server*> running_server{nullptr};
+
+extern "C" void stop_server(int) {
+    if (Server* const server = running_server.load()) {
+        server->stop();
+    }
+}
+
+// Serves the clients until the process is interrupted. Returns false after printing an error.
+[[nodiscard]] bool serve(const Options& options) {
+    try {
+        Server server(options.socket_path, options.tolerance);
+        running_server = &server;
+        struct sigaction action{};
+        action.sa_handler = stop_server;
+        sigaction(SIGINT, &action, nullptr);
+        sigaction(SIGTERM, &action, nullptr);
+        std::cout << "Listening on " << options.socket_path << std::endl;
+        // The server must be unregistered before it's destroyed, even if `run` throws.
+        try {
+            server.run();
+        } catch (...) {
+            running_server = nullptr;
+            throw;
+        }
+        running_server = nullptr;
+    } catch (const Exception& e) {
+        std::cerr << e.what() << '\n';
+        return false;
+    }
+    return true;
+}
+
+}
+
+int main(const int argc, const char* const* const argv) {
+    const std::optional<Options> options = parse_options(argc, argv);
+    if (!options) {
+        return 1;
+    }
+    if (options->socket_path) {
+        return serve(*options) ? 0 : 1;
+    }
+    if (!options->meshes.empty()) {
+        return check_meshes(*options) ? 0 : 1;
+    }
+
+    std::optional<PerformanceCounters> counters;
+    if (options->perf_counters) {
+        counters.emplace();
+    }
+    std::optional<ResultCache> cache;
+    if (options->cache_path) {
+        try {
+            cache.emplace(options->cache_path);
+        } catch (const Exception& e) {
+            std::cerr << e.what() << '\n';
+            return 1;
+        }
+    }
+
+    std::cout << std::boolalpha;
+
+    for (const char* const file: options->files) {
+        if (options->shards > 1 || options->pipeline) {
+            if (!(options->pipeline ? check_in_pipeline(file, *options) : check_in_shards(file, *options))) {
+                return 1;
+            }
+            continue;
+        }
+
+        std::ifstream in(file);
+        TestFileReader reader(in);
+        Summary summary;
+        Profile profile;
+        try {
+            check_tests(reader, *options, counters ? &*counters : nullptr, cache ? &*cache : nullptr, summary,
+                        profile, [](const TestCase& test, bool) {
+                            print_failure(test.line_index, test.expected_answer);
+                        });
+        } catch (const Exception& e) {
+            std::cerr << file << ": " << e.what() << '\n';
+            return 1;
+        }
+        print_summary(summary);
+        if (cache) {
+            std::cout << "Cache: " << summary.number_of_cache_hits << " of " << summary.number_of_tests
+                      << " tests were answered from the cache";
+            if (summary.number_of_tests) {
+                std::cout << " (" << std::fixed << std::setprecision(1)
+                          << 100.0 * summary.number_of_cache_hits / summary.number_of_tests << "%)" << std::defaultfloat;
+            }
+            std::cout << ", " << cache->size() << " entries\n";
+        }
+        if (options->timing) {
+            print_latencies(profile.latencies, profile.slowest_pairs);
+        }
+        if (counters) {
+            profile.counters_report.print(std::cout, *counters);
+        }
     }
 }
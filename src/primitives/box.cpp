@@ -0,0 +1,119 @@
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+#include "intersection_of_two_triangles/primitives/box.hpp"
+#include "intersection_of_two_triangles/primitives/general_triangle.hpp"
+
+namespace intersection_of_two_triangles {
+
+namespace {
+
+constexpr double infinity = std::numeric_limits<double>::infinity();
+
+}
+
+Box::Box() : min(infinity, infinity, infinity), max(-infinity, -infinity, -infinity) {}
+
+Box::Box(const Point& min, const Point& max) : min(min), max(max) {}
+
+bool Box::is_empty() const {
+    return min.x() > max.x() || min.y() > max.y() || min.z() > max.z();
+}
+
+bool Box::contains(const Point& p) const {
+    for (size_t i = 0; i < 3; ++i) {
+        if (p[i] < min[i] || max[i] < p[i]) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+Point Box::center() const {
+    return {(min.x() + max.x()) / 2, (min.y() + max.y()) / 2, (min.z() + max.z()) / 2};
+}
+
+double Box::extent(const size_t which) const {
+    return max[which] - min[which];
+}
+
+size_t Box::longest_axis() const {
+    size_t result = 0;
+    for (size_t i = 1; i < 3; ++i) {
+        if (extent(i) > extent(result)) {
+            result = i;
+        }
+    }
+
+    return result;
+}
+
+double Box::magnitude() const {
+    double result = 0;
+    for (size_t i = 0; i < 3; ++i) {
+        result = std::max({result, std::abs(min[i]), std::abs(max[i])});
+    }
+
+    return result;
+}
+
+Box Box::inflated(const double margin) const {
+    assert(margin >= 0);
+    return {{min.x() - margin, min.y() - margin, min.z() - margin},
+            {max.x() + margin, max.y() + margin, max.z() + margin}};
+}
+
+void Box::expand(const Point& p) {
+    for (size_t i = 0; i < 3; ++i) {
+        min[i] = std::min(min[i], p[i]);
+        max[i] = std::max(max[i], p[i]);
+    }
+}
+
+void Box::expand(const Box& b) {
+    if (!b.is_empty()) {
+        expand(b.min);
+        expand(b.max);
+    }
+}
+
+bool are_intersecting(const Box& b1, const Box& b2) {
+    for (size_t i = 0; i < 3; ++i) {
+        if (b1.max[i] < b2.min[i] || b2.max[i] < b1.min[i]) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+double distance(const Box& b1, const Box& b2) {
+    if (b1.is_empty() || b2.is_empty()) {
+        return std::numeric_limits<double>::infinity();
+    }
+    double result = 0;
+    for (size_t i = 0; i < 3; ++i) {
+        const double gap = std::max({0.0, b1.min[i] - b2.max[i], b2.min[i] - b1.max[i]});
+        result += gap * gap;
+    }
+    return std::sqrt(result);
+}
+
+Box bounding_box(const GeneralTriangle& gt) {
+    Box result;
+    for (const Point& vertex: gt.vertices) {
+        result.expand(vertex);
+    }
+
+    return result;
+}
+
+Box conservative_bounding_box(const GeneralTriangle& gt, const Tolerance& tolerance) {
+    const Box box = bounding_box(gt);
+    return box.inflated(std::sqrt(tolerance.absolute_epsilon) + 64 * tolerance.relative_epsilon * box.magnitude());
+}
+
+}
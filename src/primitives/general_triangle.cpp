@@ -18,12 +18,12 @@ enum class Equal {
     kExactly,
 };
 
-Equal compare(const Point& a, const Point& b) {
+Equal compare(const Point& a, const Point& b, const Tolerance& tolerance) {
     if (are_exactly_equal(a, b)) {
         return Equal::kExactly;
     }
 
-    if (are_nearly_equal(a, b)) {
+    if (are_nearly_equal(a, b, tolerance)) {
         return Equal::kAlmost;
     }
 
@@ -32,13 +32,13 @@ Equal compare(const Point& a, const Point& b) {
 
 }
 
-GeneralTriangle::Decomposed GeneralTriangle::as_non_degenerate() const {
+GeneralTriangle::Decomposed GeneralTriangle::as_non_degenerate(const Tolerance& tolerance) const {
     std::array<Equal, 3> equal{};
     size_t equalities_number = 0;
     std::vector<Point> unique_vertices;
 
     for (size_t i1 = 2, i2 = 0; i2 < 3; i1 = i2++) {
-        equal[i1] = compare(vertices[i1], vertices[i2]);
+        equal[i1] = compare(vertices[i1], vertices[i2], tolerance);
         equalities_number += equal[i1] != Equal::kNo;
         if (equal[i1] != Equal::kExactly) {
             unique_vertices.push_back(vertices[i2]);
@@ -54,7 +54,7 @@ GeneralTriangle::Decomposed GeneralTriangle::as_non_degenerate() const {
 
     if (equalities_number == 0) {
         try {
-            Plane(vertices[0], vertices[1], vertices[2]);
+            Plane(vertices[0], vertices[1], vertices[2], tolerance);
         } catch (const Exception&) {
             std::array<double, 3> side_lengths;
             for (size_t i = 0; i < 3; ++i) {
@@ -63,17 +63,17 @@ GeneralTriangle::Decomposed GeneralTriangle::as_non_degenerate() const {
             const double* const max = std::max_element(side_lengths.begin(), side_lengths.end());
             const size_t middle_index = max - side_lengths.begin();
             assert(0 <= middle_index && middle_index <= 2);
-            return {edge(middle_index), vertices[middle_index]};
+            return {edge(middle_index, tolerance), vertices[middle_index]};
         }
-        return {Triangle(vertices[0], vertices[1], vertices[2])};
+        return {Triangle(vertices[0], vertices[1], vertices[2], tolerance)};
     }
 
     for (size_t i = 0; i < 3; ++i) {
         if (equal[i] == Equal::kExactly) {
-            return {edge(i)};
+            return {edge(i, tolerance)};
         }
         if (equal[i] == Equal::kAlmost) {
-            return {edge(i), edge((i + 1) % 3)};
+            return {edge(i, tolerance), edge((i + 1) % 3, tolerance)};
         }
     }
 
@@ -81,8 +81,8 @@ GeneralTriangle::Decomposed GeneralTriangle::as_non_degenerate() const {
     return {};
 }
 
-Segment GeneralTriangle::edge(const size_t which) const {
-    return {vertices[(which + 1) % 3], vertices[(which + 2) % 3]};
+Segment GeneralTriangle::edge(const size_t which, const Tolerance& tolerance) const {
+    return {vertices[(which + 1) % 3], vertices[(which + 2) % 3], tolerance};
 }
 
 }
@@ -0,0 +1,122 @@
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+
+#include "intersection_of_two_triangles/primitives/mesh.hpp"
+
+namespace intersection_of_two_triangles {
+
+namespace {
+
+using Key = std::array<std::uint64_t, 3>;
+
+struct KeyHash {
+    [[nodiscard]] size_t operator()(const Key& key) const {
+        std::uint64_t result = 0;
+        for (const std::uint64_t word: key) {
+            result = (result ^ word) * 0x9E3779B97F4A7C15;
+            result ^= result >> 29;
+        }
+        return static_cast<size_t>(result);
+    }
+};
+
+// The exact coordinates, with -0 turned into +0, since they compare equal.
+[[nodiscard]] Key exact_key(const Point& p) {
+    Key result{};
+    for (size_t i = 0; i < 3; ++i) {
+        const double coordinate = p[i] + 0.0;
+        std::memcpy(&result[i], &coordinate, sizeof(coordinate));
+    }
+    return result;
+}
+
+[[nodiscard]] Key cell_key(const Point& p, const double cell_size, const std::array<std::int64_t, 3>& offset = {}) {
+    Key result{};
+    for (size_t i = 0; i < 3; ++i) {
+        result[i] = static_cast<std::uint64_t>(static_cast<std::int64_t>(std::floor(p[i] / cell_size)) + offset[i]);
+    }
+    return result;
+}
+
+}
+
+GeneralTriangle Mesh::triangle(const size_t which) const {
+    const Face& face = faces[which];
+    return {vertices[face[0]], vertices[face[1]], vertices[face[2]]};
+}
+
+std::vector<GeneralTriangle> Mesh::triangles() const {
+    std::vector<GeneralTriangle> result;
+    result.reserve(faces.size());
+    for (size_t i = 0; i < faces.size(); ++i) {
+        result.push_back(triangle(i));
+    }
+    return result;
+}
+
+bool Mesh::are_adjacent(const size_t face1, const size_t face2) const {
+    for (const size_t v1: faces[face1]) {
+        for (const size_t v2: faces[face2]) {
+            if (v1 == v2) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void weld_vertices(Mesh& mesh, const double distance) {
+    std::vector<size_t> renumbering(mesh.vertices.size());
+    std::vector<Point> welded;
+
+    if (distance == 0) {
+        std::unordered_map<Key, size_t, KeyHash> indices;
+        indices.reserve(mesh.vertices.size());
+        for (size_t i = 0; i < mesh.vertices.size(); ++i) {
+            const auto [it, inserted] = indices.try_emplace(exact_key(mesh.vertices[i]), welded.size());
+            if (inserted) {
+                welded.push_back(mesh.vertices[i]);
+            }
+            renumbering[i] = it->second;
+        }
+    } else {
+        // The kept vertices are hashed into cells of the size `distance`, so the vertices closer than it are in
+        // the same or in the neighbouring cells.
+        std::unordered_map<Key, std::vector<size_t>, KeyHash> cells;
+        for (size_t i = 0; i < mesh.vertices.size(); ++i) {
+            const Point& p = mesh.vertices[i];
+            std::optional<size_t> found;
+            for (std::int64_t n = 0; n < 27 && !found; ++n) {
+                const auto it = cells.find(cell_key(p, distance, {n % 3 - 1, n / 3 % 3 - 1, n / 9 - 1}));
+                if (it == cells.end()) {
+                    continue;
+                }
+                for (const size_t candidate: it->second) {
+                    if (intersection_of_two_triangles::distance(p, welded[candidate]) < distance) {
+                        found = candidate;
+                        break;
+                    }
+                }
+            }
+            if (!found) {
+                found = welded.size();
+                cells[cell_key(p, distance)].push_back(welded.size());
+                welded.push_back(p);
+            }
+            renumbering[i] = *found;
+        }
+    }
+
+    for (Mesh::Face& face: mesh.faces) {
+        for (size_t& vertex: face) {
+            vertex = renumbering[vertex];
+        }
+    }
+    mesh.vertices = std::move(welded);
+}
+
+}
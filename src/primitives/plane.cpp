@@ -12,21 +12,26 @@
 
 namespace intersection_of_two_triangles {
 
-Plane::Plane(const Point& a, const Point& b, const Point& c) :
-    normal(cross_product(b - a, c - a)), d(-dot_product(normal, a.radius_vector())) {
-    if (normal.is_zero()) {
+Plane::Plane(const Point& a, const Point& b, const Point& c, const Tolerance& tolerance) :
+    normal(cross_product(b - a, c - a, tolerance)),
+    d(-dot_product(normal, a.radius_vector(), tolerance.of_degree(3))) {
+    if (normal.is_zero(tolerance)) {
         throw Exception("Plane::Plane: the given points are collinear");
     }
 }
 
-double Plane::signed_distance(const Point& to) const {
-    return dot_product(normal, to.radius_vector()) + d;
+double Plane::signed_distance(const Point& to, const Tolerance& tolerance) const {
+    return dot_product(normal, to.radius_vector(), tolerance.of_degree(3)) + d;
 }
 
-std::optional<Line> intersection(const Plane& p1, const Plane& p2) {
-    const Vector direction = cross_product(p1.normal, p2.normal);
+std::optional<Line> intersection(const Plane& p1, const Plane& p2, const Tolerance& tolerance) {
+    // The normals are of degree 2 in the coordinates, so the direction and the determinants of their coordinates are
+    // of degree 4, and the determinants involving d of degree 5.
+    const Tolerance quartic = tolerance.of_degree(4);
+    const Tolerance quintic = tolerance.of_degree(5);
+    const Vector direction = cross_product(p1.normal, p2.normal, quartic);
 
-    if (direction.is_zero()) {
+    if (direction.is_zero(quartic)) {
         return std::nullopt;
     }
 
@@ -35,27 +40,27 @@ std::optional<Line> intersection(const Plane& p1, const Plane& p2) {
             const size_t not_chosen = 3 - coord0 - coord1;
             const std::array<std::array<double, 2>, 2> chosen{
                 {
-                    {p1.normal.coord(coord0),
-                     p2.normal.coord(coord0)},
-                    {p1.normal.coord(coord1),
-                     p2.normal.coord(coord1)},
+                    {p1.normal[coord0],
+                     p2.normal[coord0]},
+                    {p1.normal[coord1],
+                     p2.normal[coord1]},
                 }
             };
             const std::array<double, 2> ds{p1.d, p2.d};
-            const double chosen_det = determinant(chosen[0], chosen[1]);
+            const double chosen_det = determinant(chosen[0], chosen[1], quartic);
             if (chosen_det == 0) {
                 continue;
             }
             Point point_on_result(0, 0, 0);
-            point_on_result.coord(coord0) = determinant(ds, chosen[1]) / -chosen_det;
-            point_on_result.coord(coord1) = determinant(ds, chosen[0]) / +chosen_det;
+            point_on_result[coord0] = determinant(ds, chosen[1], quintic) / -chosen_det;
+            point_on_result[coord1] = determinant(ds, chosen[0], quintic) / +chosen_det;
             for (const Plane* const p: {&p1, &p2}) {
-                if (!are_nearly_equal(0, p->normal.coord(not_chosen))) {
-                    point_on_result.coord(not_chosen) =
+                if (!is_nearly_zero(p->normal[not_chosen], tolerance)) {
+                    point_on_result[not_chosen] =
                         -(p->d +
-                          p->normal.coord(coord0) * point_on_result.coord(coord0) +
-                          p->normal.coord(coord1) * point_on_result.coord(coord1)) /
-                        p->normal.coord(not_chosen);
+                          p->normal[coord0] * point_on_result[coord0] +
+                          p->normal[coord1] * point_on_result[coord1]) /
+                        p->normal[not_chosen];
                     break;
                 }
             }
@@ -0,0 +1,58 @@
+#include <cmath>
+
+#include "intersection_of_two_triangles/exception.hpp"
+#include "intersection_of_two_triangles/primitives/general_triangle.hpp"
+#include "intersection_of_two_triangles/primitives/quantized_triangle.hpp"
+
+namespace intersection_of_two_triangles {
+
+bool operator==(const LatticePoint& a, const LatticePoint& b) {
+    return a.x == b.x && a.y == b.y && a.z == b.z;
+}
+
+Quantizer::Quantizer(const double resolution) : resolution_(resolution) {
+    if (!(resolution > 0) || !std::isfinite(resolution)) {
+        throw Exception("Quantizer::Quantizer: the resolution must be a positive number");
+    }
+}
+
+double Quantizer::resolution() const {
+    return resolution_;
+}
+
+LatticePoint Quantizer::quantize(const Point& p) const {
+    std::array<std::int64_t, 3> result{};
+    for (size_t i = 0; i < 3; ++i) {
+        const double scaled = std::round(p[i] / resolution_);
+        if (!(std::abs(scaled) <= static_cast<double>(max_coordinate))) {
+            throw Exception("Quantizer::quantize: the point is out of the lattice bounds");
+        }
+        result[i] = static_cast<std::int64_t>(scaled);
+    }
+
+    return {result[0], result[1], result[2]};
+}
+
+QuantizedTriangle Quantizer::quantize(const GeneralTriangle& gt) const {
+    return {{quantize(gt.vertices[0]), quantize(gt.vertices[1]), quantize(gt.vertices[2])}};
+}
+
+Point Quantizer::restore(const LatticePoint& p) const {
+    return {static_cast<double>(p.x) * resolution_,
+            static_cast<double>(p.y) * resolution_,
+            static_cast<double>(p.z) * resolution_};
+}
+
+bool Quantizer::is_on_lattice(const Point& p) const {
+    for (size_t i = 0; i < 3; ++i) {
+        const double scaled = p[i] / resolution_;
+        if (!(std::abs(scaled) <= static_cast<double>(max_coordinate)) || scaled != std::round(scaled) ||
+            std::round(scaled) * resolution_ != p[i]) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+}
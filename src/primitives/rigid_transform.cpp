@@ -0,0 +1,89 @@
+#include <cmath>
+#include <limits>
+
+#include "intersection_of_two_triangles/primitives/rigid_transform.hpp"
+
+namespace intersection_of_two_triangles {
+
+namespace {
+
+[[nodiscard]] double dot(const Vector& v1, const Vector& v2) {
+    return v1.x() * v2.x() + v1.y() * v2.y() + v1.z() * v2.z();
+}
+
+}
+
+RigidTransform RigidTransform::rotation(const Vector& axis, const double angle, const Vector& translation) {
+    const Vector u = (1 / axis.length()) * axis;
+    const double c = std::cos(angle);
+    const double s = std::sin(angle);
+    const double t = 1 - c;
+    RigidTransform result;
+    // Rodrigues' rotation formula.
+    result.rotation_rows = {
+        Vector(t * u.x() * u.x() + c, t * u.x() * u.y() - s * u.z(), t * u.x() * u.z() + s * u.y()),
+        Vector(t * u.x() * u.y() + s * u.z(), t * u.y() * u.y() + c, t * u.y() * u.z() - s * u.x()),
+        Vector(t * u.x() * u.z() - s * u.y(), t * u.y() * u.z() + s * u.x(), t * u.z() * u.z() + c),
+    };
+    result.translation = translation;
+    return result;
+}
+
+Point RigidTransform::operator()(const Point& p) const {
+    return (*this)(p.radius_vector()).as_point() + translation;
+}
+
+Vector RigidTransform::operator()(const Vector& v) const {
+    return {dot(rotation_rows[0], v), dot(rotation_rows[1], v), dot(rotation_rows[2], v)};
+}
+
+GeneralTriangle RigidTransform::operator()(const GeneralTriangle& gt) const {
+    return {(*this)(gt.vertices[0]), (*this)(gt.vertices[1]), (*this)(gt.vertices[2])};
+}
+
+Segment RigidTransform::operator()(const Segment& s, const Tolerance& tolerance) const {
+    return {(*this)(s.endpoint(0)), (*this)(s.endpoint(1)), tolerance};
+}
+
+Box RigidTransform::operator()(const Box& box) const {
+    if (box.is_empty()) {
+        return box;
+    }
+    // Each coordinate of the image is a sum of terms linear in the coordinates, so its extremes are the sums of the
+    // extremes of the terms.
+    const Point origin = translation.as_point();
+    Box result(origin, origin);
+    for (size_t i = 0; i < 3; ++i) {
+        for (size_t j = 0; j < 3; ++j) {
+            const double a = rotation_rows[i][j] * box.min[j];
+            const double b = rotation_rows[i][j] * box.max[j];
+            result.min[i] += std::min(a, b);
+            result.max[i] += std::max(a, b);
+        }
+    }
+    return result.inflated(8 * std::numeric_limits<double>::epsilon() * (box.magnitude() + result.magnitude()));
+}
+
+RigidTransform RigidTransform::inverse() const {
+    RigidTransform result;
+    for (size_t i = 0; i < 3; ++i) {
+        result.rotation_rows[i] = {rotation_rows[0][i], rotation_rows[1][i], rotation_rows[2][i]};
+    }
+    result.translation = -result(translation);
+    return result;
+}
+
+RigidTransform operator*(const RigidTransform& second, const RigidTransform& first) {
+    RigidTransform result;
+    for (size_t i = 0; i < 3; ++i) {
+        for (size_t j = 0; j < 3; ++j) {
+            result.rotation_rows[i][j] = second.rotation_rows[i][0] * first.rotation_rows[0][j] +
+                                         second.rotation_rows[i][1] * first.rotation_rows[1][j] +
+                                         second.rotation_rows[i][2] * first.rotation_rows[2][j];
+        }
+    }
+    result.translation = second(first.translation) + second.translation;
+    return result;
+}
+
+}
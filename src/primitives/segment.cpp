@@ -5,10 +5,10 @@
 
 namespace intersection_of_two_triangles {
 
-Segment::Segment(const Point& a, const Point& b) : endpoints{a, b} {
+Segment::Segment(const Point& a, const Point& b, const Tolerance& tolerance) : endpoints{a, b} {
     const Vector ab = b.radius_vector() - a.radius_vector();
 
-    if (dot_product(ab, ab) == 0) {
+    if (dot_product(ab, ab, tolerance) == 0) {
         throw Exception("Segment::Segment: the given points are too close");
     }
 }
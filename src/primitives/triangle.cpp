@@ -5,10 +5,11 @@
 
 namespace intersection_of_two_triangles {
 
-Triangle::Triangle(const Point& a, const Point& b, const Point& c) : vertices{a, b, c} {
-    assert(!are_nearly_equal(a, b));
-    assert(!are_nearly_equal(b, c));
-    assert(!are_nearly_equal(c, a));
+Triangle::Triangle(const Point& a, const Point& b, const Point& c, [[maybe_unused]] const Tolerance& tolerance) :
+    vertices{a, b, c} {
+    assert(!are_nearly_equal(a, b, tolerance));
+    assert(!are_nearly_equal(b, c, tolerance));
+    assert(!are_nearly_equal(c, a, tolerance));
 }
 
 const Point& Triangle::vertex(const size_t which) const {
@@ -16,8 +17,8 @@ const Point& Triangle::vertex(const size_t which) const {
     return vertices[which];
 }
 
-Segment Triangle::edge(const size_t which) const {
-    return {vertices[(which + 1) % 3], vertices[(which + 2) % 3]};
+Segment Triangle::edge(const size_t which, const Tolerance& tolerance) const {
+    return {vertices[(which + 1) % 3], vertices[(which + 2) % 3], tolerance};
 }
 
 }
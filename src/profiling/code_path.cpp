@@ -0,0 +1,35 @@
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <variant>
+
+#include "intersection_of_two_triangles/primitives/general_triangle.hpp"
+#include "intersection_of_two_triangles/primitives/segment.hpp"
+#include "intersection_of_two_triangles/primitives/triangle.hpp"
+#include "intersection_of_two_triangles/profiling/code_path.hpp"
+
+namespace intersection_of_two_triangles {
+
+namespace {
+
+[[nodiscard]] std::string describe(const GeneralTriangle::Decomposed& sub_objects) {
+    static constexpr std::array<const char*, 3> names{"point", "segment", "triangle"};
+    std::string result;
+    for (const auto& sub_object: sub_objects) {
+        result += (result.empty() ? "" : "+");
+        result += names[sub_object.index()];
+    }
+    return result;
+}
+
+}
+
+std::string code_path(const GeneralTriangle& gt1, const GeneralTriangle& gt2, const Tolerance& tolerance) {
+    std::array<std::string, 2> descriptions{describe(gt1.as_non_degenerate(tolerance)),
+                                            describe(gt2.as_non_degenerate(tolerance))};
+    // The overloads are symmetric, so the order of the triangles doesn't matter.
+    std::sort(descriptions.begin(), descriptions.end(), std::greater<>());
+    return descriptions[0] + " / " + descriptions[1];
+}
+
+}
@@ -0,0 +1,107 @@
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <functional>
+#include <limits>
+
+#include "intersection_of_two_triangles/profiling/latency_histogram.hpp"
+
+namespace intersection_of_two_triangles {
+
+namespace {
+
+constexpr size_t sub_buckets = size_t{1} << LatencyHistogram::sub_bucket_bits;
+
+[[nodiscard]] size_t highest_bit(std::uint64_t value) {
+    assert(value != 0);
+    size_t result = 0;
+    while (value >>= 1) {
+        ++result;
+    }
+    return result;
+}
+
+// The values below `sub_buckets` have buckets of their own. The larger values in [2^e, 2^(e+1)) are shifted right by
+// `e - sub_bucket_bits`, which leaves `sub_buckets` distinct values.
+[[nodiscard]] size_t bucket_index(const std::uint64_t value) {
+    if (value < sub_buckets) {
+        return value;
+    }
+    const size_t shift = highest_bit(value) - LatencyHistogram::sub_bucket_bits;
+    return ((shift + 1) << LatencyHistogram::sub_bucket_bits) + (value >> shift) - sub_buckets;
+}
+
+// The largest value of the bucket.
+[[nodiscard]] std::uint64_t bucket_value(const size_t index) {
+    if (index < sub_buckets) {
+        return index;
+    }
+    const size_t shift = (index >> LatencyHistogram::sub_bucket_bits) - 1;
+    const std::uint64_t sub_bucket = (index & (sub_buckets - 1)) + sub_buckets;
+    return ((sub_bucket + 1) << shift) - 1;
+}
+
+}
+
+LatencyHistogram::LatencyHistogram() : counts_(bucket_index(std::numeric_limits<std::uint64_t>::max()) + 1) {}
+
+void LatencyHistogram::record(const std::uint64_t nanoseconds) {
+    ++counts_[bucket_index(nanoseconds)];
+    ++count_;
+    max_ = std::max(max_, nanoseconds);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    for (size_t i = 0; i < counts_.size(); ++i) {
+        counts_[i] += other.counts_[i];
+    }
+    count_ += other.count_;
+    max_ = std::max(max_, other.max_);
+}
+
+std::uint64_t LatencyHistogram::count() const {
+    return count_;
+}
+
+std::uint64_t LatencyHistogram::max() const {
+    return max_;
+}
+
+std::uint64_t LatencyHistogram::percentile(const double percent) const {
+    assert(0 <= percent && percent <= 100);
+    if (count_ == 0) {
+        return 0;
+    }
+    const auto rank = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(std::ceil(percent / 100 * count_)));
+    std::uint64_t seen = 0;
+    for (size_t i = 0; i < counts_.size(); ++i) {
+        seen += counts_[i];
+        if (seen >= rank) {
+            return std::min(bucket_value(i), max_);
+        }
+    }
+    return max_;
+}
+
+SlowestSamples::SlowestSamples(const size_t capacity) : capacity_(capacity) {
+    heap_.reserve(capacity);
+}
+
+void SlowestSamples::record(const std::uint64_t nanoseconds, const size_t sample) {
+    if (heap_.size() < capacity_) {
+        heap_.emplace_back(nanoseconds, sample);
+        std::push_heap(heap_.begin(), heap_.end(), std::greater<>());
+    } else if (capacity_ != 0 && heap_.front().first < nanoseconds) {
+        std::pop_heap(heap_.begin(), heap_.end(), std::greater<>());
+        heap_.back() = {nanoseconds, sample};
+        std::push_heap(heap_.begin(), heap_.end(), std::greater<>());
+    }
+}
+
+std::vector<std::pair<std::uint64_t, size_t>> SlowestSamples::sorted() const {
+    auto result = heap_;
+    std::sort(result.begin(), result.end(), std::greater<>());
+    return result;
+}
+
+}
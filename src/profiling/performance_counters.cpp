@@ -0,0 +1,169 @@
+#include <cerrno>
+#include <cstring>
+#include <iomanip>
+
+#include "intersection_of_two_triangles/profiling/performance_counters.hpp"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace intersection_of_two_triangles {
+
+namespace {
+
+constexpr std::array<const char*, number_of_counters> counter_names{
+    "cycles",
+    "instructions",
+    "branch-misses",
+    "cache-misses",
+};
+
+#ifdef __linux__
+constexpr std::array<std::uint64_t, number_of_counters> counter_configs{
+    PERF_COUNT_HW_CPU_CYCLES,
+    PERF_COUNT_HW_INSTRUCTIONS,
+    PERF_COUNT_HW_BRANCH_MISSES,
+    PERF_COUNT_HW_CACHE_MISSES,
+};
+
+[[nodiscard]] int open_counter(const std::uint64_t config, const int group) {
+    perf_event_attr attributes{};
+    attributes.size = sizeof(attributes);
+    attributes.type = PERF_TYPE_HARDWARE;
+    attributes.config = config;
+    attributes.disabled = group == -1;
+    attributes.exclude_kernel = 1;
+    attributes.exclude_hv = 1;
+    attributes.read_format = PERF_FORMAT_GROUP;
+    return static_cast<int>(syscall(SYS_perf_event_open, &attributes, 0, -1, group, 0));
+}
+#endif
+
+}
+
+PerformanceCounters::PerformanceCounters() {
+    descriptors_.fill(-1);
+    positions_.fill(number_of_counters);
+
+#ifdef __linux__
+    for (size_t i = 0; i < number_of_counters; ++i) {
+        descriptors_[i] = open_counter(counter_configs[i], leader_);
+        if (descriptors_[i] == -1) {
+            unavailability_reason_ += std::string(unavailability_reason_.empty() ? "" : "; ") + counter_names[i] +
+                                      ": " + std::strerror(errno);
+            continue;
+        }
+        if (leader_ == -1) {
+            leader_ = descriptors_[i];
+        }
+        positions_[i] = number_of_open_counters_++;
+    }
+    if (leader_ != -1) {
+        ioctl(leader_, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(leader_, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+#else
+    unavailability_reason_ = "performance counters are supported only on Linux";
+#endif
+}
+
+PerformanceCounters::~PerformanceCounters() {
+#ifdef __linux__
+    for (const int descriptor: descriptors_) {
+        if (descriptor != -1) {
+            close(descriptor);
+        }
+    }
+#endif
+}
+
+bool PerformanceCounters::available() const {
+    return number_of_open_counters_ != 0;
+}
+
+bool PerformanceCounters::available(const Counter counter) const {
+    return positions_[static_cast<size_t>(counter)] != number_of_counters;
+}
+
+const std::string& PerformanceCounters::unavailability_reason() const {
+    return unavailability_reason_;
+}
+
+CounterValues PerformanceCounters::read() const {
+    CounterValues result{};
+#ifdef __linux__
+    if (!available()) {
+        return result;
+    }
+    // The group read format is the number of counters followed by their values.
+    std::array<std::uint64_t, number_of_counters + 1> buffer{};
+    if (::read(leader_, buffer.data(), sizeof(buffer)) <= 0) {
+        return result;
+    }
+    for (size_t i = 0; i < number_of_counters; ++i) {
+        if (positions_[i] < buffer[0]) {
+            result[i] = buffer[1 + positions_[i]];
+        }
+    }
+#endif
+    return result;
+}
+
+void PerformanceCountersReport::add(const std::string& path, const CounterValues& begin, const CounterValues& end) {
+    Totals& totals = paths_[path];
+    ++totals.count;
+    for (size_t i = 0; i < number_of_counters; ++i) {
+        totals.values[i] += end[i] - begin[i];
+    }
+}
+
+void PerformanceCountersReport::print(std::ostream& out, const PerformanceCounters& counters) const {
+    if (!counters.available()) {
+        out << "Performance counters are unavailable: " << counters.unavailability_reason() << '\n';
+        return;
+    }
+    if (!counters.unavailability_reason().empty()) {
+        out << "Some performance counters are unavailable: " << counters.unavailability_reason() << '\n';
+    }
+
+    const auto flags = out.flags();
+    const auto precision = out.precision();
+    out << std::fixed << std::setprecision(1) << "Performance counters per pair:\n"
+        << std::left << std::setw(36) << "  path" << std::right << std::setw(10) << "pairs";
+    for (size_t i = 0; i < number_of_counters; ++i) {
+        if (counters.available(static_cast<Counter>(i))) {
+            out << std::setw(15) << counter_names[i];
+        }
+    }
+    out << '\n';
+
+    Totals all;
+    const auto print_row = [&](const std::string& path, const Totals& totals) {
+        out << "  " << std::left << std::setw(34) << path << std::right << std::setw(10) << totals.count;
+        for (size_t i = 0; i < number_of_counters; ++i) {
+            if (counters.available(static_cast<Counter>(i))) {
+                out << std::setw(15) << static_cast<double>(totals.values[i]) / totals.count;
+            }
+        }
+        out << '\n';
+    };
+    for (const auto& [path, totals]: paths_) {
+        print_row(path, totals);
+        all.count += totals.count;
+        for (size_t i = 0; i < number_of_counters; ++i) {
+            all.values[i] += totals.values[i];
+        }
+    }
+    if (all.count != 0) {
+        print_row("all", all);
+    }
+
+    out.flags(flags);
+    out.precision(precision);
+}
+
+}
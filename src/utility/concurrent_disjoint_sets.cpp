@@ -0,0 +1,64 @@
+#include <utility>
+
+#include "intersection_of_two_triangles/utility/concurrent_disjoint_sets.hpp"
+
+namespace intersection_of_two_triangles {
+
+ConcurrentDisjointSets::ConcurrentDisjointSets(const size_t size) :
+    size_(size), parents_(std::make_unique<std::atomic<size_t>[]>(size)) {
+    for (size_t i = 0; i < size; ++i) {
+        parents_[i].store(i, std::memory_order_relaxed);
+    }
+}
+
+size_t ConcurrentDisjointSets::size() const {
+    return size_;
+}
+
+size_t ConcurrentDisjointSets::find(size_t x) {
+    for (; ; ) {
+        size_t parent = parents_[x].load(std::memory_order_acquire);
+        if (parent == x) {
+            return x;
+        }
+        const size_t grandparent = parents_[parent].load(std::memory_order_acquire);
+        if (parent != grandparent) {
+            // Another thread may have changed the parent, then the halving is just skipped.
+            parents_[x].compare_exchange_weak(parent, grandparent, std::memory_order_acq_rel);
+        }
+        x = grandparent;
+    }
+}
+
+bool ConcurrentDisjointSets::are_united(size_t a, size_t b) {
+    for (; ; ) {
+        a = find(a);
+        b = find(b);
+        if (a == b) {
+            return true;
+        }
+        // If `a` is still a root, the sets were different at the moment of this check.
+        if (parents_[a].load(std::memory_order_acquire) == a) {
+            return false;
+        }
+    }
+}
+
+void ConcurrentDisjointSets::unite(size_t a, size_t b) {
+    for (; ; ) {
+        a = find(a);
+        b = find(b);
+        if (a == b) {
+            return;
+        }
+        if (a < b) {
+            std::swap(a, b);
+        }
+        size_t expected = a;
+        if (parents_[a].compare_exchange_strong(expected, b, std::memory_order_acq_rel)) {
+            return;
+        }
+    }
+}
+
+}
@@ -0,0 +1,50 @@
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "intersection_of_two_triangles/exception.hpp"
+#include "intersection_of_two_triangles/utility/mapped_file.hpp"
+
+namespace intersection_of_two_triangles {
+
+MappedFile::MappedFile(const std::string& path) {
+    const int descriptor = open(path.c_str(), O_RDONLY);
+    if (descriptor < 0) {
+        throw Exception(path + ": " + std::strerror(errno));
+    }
+    struct stat status{};
+    if (fstat(descriptor, &status) != 0) {
+        const int error = errno;
+        close(descriptor);
+        throw Exception(path + ": " + std::strerror(error));
+    }
+    size_ = static_cast<size_t>(status.st_size);
+    // An empty file can't be mapped, and it has no contents to map.
+    if (size_ != 0) {
+        void* const data = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, descriptor, 0);
+        if (data == MAP_FAILED) {
+            const int error = errno;
+            close(descriptor);
+            throw Exception(path + ": mmap failed: " + std::strerror(error));
+        }
+        madvise(data, size_, MADV_SEQUENTIAL);
+        data_ = static_cast<const char*>(data);
+    }
+    close(descriptor);
+}
+
+MappedFile::~MappedFile() {
+    if (data_) {
+        munmap(const_cast<char*>(data_), size_);
+    }
+}
+
+std::string_view MappedFile::contents() const {
+    return {data_, size_};
+}
+
+}
@@ -0,0 +1,9 @@
+#include "intersection_of_two_triangles/utility/parallel_for.hpp"
+
+namespace intersection_of_two_triangles {
+
+size_t default_number_of_threads() {
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+}
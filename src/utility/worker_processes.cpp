@@ -0,0 +1,137 @@
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "intersection_of_two_triangles/exception.hpp"
+#include "intersection_of_two_triangles/utility/worker_processes.hpp"
+
+namespace intersection_of_two_triangles {
+
+namespace {
+
+struct Worker {
+    pid_t pid = -1;
+    int fd = -1;
+};
+
+[[nodiscard]] bool write_all(const int fd, const std::string& data) {
+    for (size_t written = 0; written < data.size(); ) {
+        const ssize_t result = write(fd, data.data() + written, data.size() - written);
+        if (result < 0 && errno != EINTR) {
+            return false;
+        }
+        written += std::max<ssize_t>(result, 0);
+    }
+    return true;
+}
+
+[[noreturn]] void run_worker(const size_t index, const std::function<std::string(size_t)>& work, const int fd) {
+    bool succeeded = false;
+    try {
+        succeeded = write_all(fd, work(index));
+    } catch (const std::exception& e) {
+        std::cerr << "worker " << index << ": " << e.what() << std::endl;
+    } catch (...) {
+    }
+    // The worker mustn't run the destructors and the exit handlers of the parent's state.
+    _exit(succeeded ? 0 : 1);
+}
+
+// Reads the pipe of the worker until it is closed.
+[[nodiscard]] std::string read_output(const Worker& worker) {
+    std::string result;
+    char buffer[1 << 16];
+    while (true) {
+        const ssize_t size = read(worker.fd, buffer, sizeof(buffer));
+        if (size < 0 && errno == EINTR) {
+            continue;
+        }
+        if (size < 0) {
+            throw Exception(std::string("read failed: ") + std::strerror(errno));
+        }
+        if (size == 0) {
+            return result;
+        }
+        result.append(buffer, static_cast<size_t>(size));
+    }
+}
+
+// Waits for the worker and returns whether it finished successfully.
+[[nodiscard]] bool wait_for(const Worker& worker) {
+    int status = 0;
+    while (waitpid(worker.pid, &status, 0) < 0 && errno == EINTR) {
+    }
+    return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+}
+
+void run_in_worker_processes(const size_t count, const std::function<std::string(size_t)>& work,
+                             const std::function<void(size_t, const std::string&)>& consume) {
+    std::cout.flush();
+    std::cerr.flush();
+    std::fflush(nullptr);
+
+    std::vector<Worker> workers;
+    std::string error;
+    for (size_t index = 0; index < count; ++index) {
+        int fds[2];
+        if (pipe(fds) != 0) {
+            error = std::string("pipe failed: ") + std::strerror(errno);
+            break;
+        }
+        const pid_t pid = fork();
+        if (pid < 0) {
+            error = std::string("fork failed: ") + std::strerror(errno);
+            close(fds[0]);
+            close(fds[1]);
+            break;
+        }
+        if (pid == 0) {
+            close(fds[0]);
+            for (const Worker& worker: workers) {
+                close(worker.fd);
+            }
+            run_worker(index, work, fds[1]);
+        }
+        close(fds[1]);
+        workers.push_back({pid, fds[0]});
+    }
+
+    // The workers are read in order, and after an error the rest of them are still drained and waited for.
+    for (size_t index = 0; index < workers.size(); ++index) {
+        std::string output;
+        try {
+            output = read_output(workers[index]);
+        } catch (const Exception& e) {
+            if (error.empty()) {
+                error = e.what();
+            }
+        }
+        close(workers[index].fd);
+        const bool succeeded = wait_for(workers[index]);
+        if (error.empty() && !succeeded) {
+            error = "a worker process failed";
+        }
+        if (error.empty()) {
+            try {
+                consume(index, output);
+            } catch (const std::exception& e) {
+                error = e.what();
+            }
+        }
+    }
+    if (!error.empty()) {
+        throw Exception(error);
+    }
+}
+
+}
@@ -0,0 +1,86 @@
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "intersection_of_two_triangles/algorithms/are_intersecting.hpp"
+#include "intersection_of_two_triangles/algorithms/batch_intersection.hpp"
+#include "intersection_of_two_triangles/algorithms/cascade_intersection.hpp"
+#include "intersection_of_two_triangles/exception.hpp"
+#include "intersection_of_two_triangles/io/test_file_reader.hpp"
+
+// Checks that `are_intersecting_cascade` and `are_intersecting_batch` answer like `are_intersecting` on the pairs of
+// a test file, both for the whole file and for its short prefixes, which leave the lanes of the last group of pairs
+// of the filter partly empty, and that the statistics of the cascade account for every pair.
+// Usage: intersection_of_two_triangles_cascade_check <test file>
+
+namespace {
+
+using namespace intersection_of_two_triangles;
+
+size_t number_of_failures = 0;
+
+void check(const bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "failed: " << what << '\n';
+        ++number_of_failures;
+    }
+}
+
+void check_pairs(const std::vector<TestCase>& tests, const size_t count) {
+    std::vector<TrianglePair> pairs;
+    std::vector<bool> expected;
+    for (size_t i = 0; i < count; ++i) {
+        pairs.push_back(tests[i].triangles);
+        expected.push_back(are_intersecting(tests[i].triangles[0], tests[i].triangles[1]));
+    }
+    const std::string name = std::to_string(count) + " pairs: ";
+
+    check(are_intersecting_batch(pairs) == expected, name + "are_intersecting_batch answers like are_intersecting");
+    CascadeStatistics statistics;
+    const std::vector<bool> answers = are_intersecting_cascade(pairs, default_tolerance, &statistics);
+    check(answers == expected, name + "are_intersecting_cascade answers like are_intersecting");
+    check(statistics.certified_disjoint + statistics.certified_intersecting + statistics.rechecked == count,
+          name + "the statistics of the cascade account for every pair");
+    for (size_t i = 0; i < std::min(answers.size(), count); ++i) {
+        check(answers[i] == tests[i].expected_answer,
+              "line " + std::to_string(tests[i].line_index) + ": the cascade gives the expected answer");
+    }
+}
+
+}
+
+int main(const int argc, const char* const* const argv) {
+    if (argc != 2) {
+        std::cerr << "Usage: intersection_of_two_triangles_cascade_check <test file>\n";
+        return 1;
+    }
+
+    try {
+        std::ifstream input(argv[1]);
+        if (!input) {
+            throw Exception(std::string("Can't open ") + argv[1]);
+        }
+        TestFileReader reader(input);
+        std::vector<TestCase> tests;
+        while (const std::optional<TestCase> test = reader.next()) {
+            tests.push_back(*test);
+        }
+        check(!tests.empty(), "the test file has pairs");
+
+        for (size_t count = 0; count <= std::min<size_t>(tests.size(), 17); ++count) {
+            check_pairs(tests, count);
+        }
+        check_pairs(tests, tests.size());
+    } catch (const Exception& e) {
+        std::cerr << e.what() << '\n';
+        return 1;
+    }
+
+    if (number_of_failures != 0) {
+        return 1;
+    }
+    std::cout << "All cascade checks passed\n";
+}
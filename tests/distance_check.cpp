@@ -0,0 +1,79 @@
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <string>
+
+#include "intersection_of_two_triangles/algorithms/are_intersecting.hpp"
+#include "intersection_of_two_triangles/algorithms/distance.hpp"
+#include "intersection_of_two_triangles/algorithms/mesh_index.hpp"
+#include "intersection_of_two_triangles/exception.hpp"
+#include "intersection_of_two_triangles/io/test_file_reader.hpp"
+
+// Checks that the distance queries agree with `are_intersecting` on the pairs of a test file: the intersecting pairs
+// are the ones within the distance 0, both for the triangles and for the indexes of one triangle each, their closest
+// points are nearly equal, and the closest points of the other pairs are apart.
+// Usage: intersection_of_two_triangles_distance_check <test file>
+
+namespace {
+
+using namespace intersection_of_two_triangles;
+
+size_t number_of_failures = 0;
+
+void check(const bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "failed: " << what << '\n';
+        ++number_of_failures;
+    }
+}
+
+void check_pair(const TestCase& test) {
+    const auto& [gt1, gt2] = test.triangles;
+    const std::string line = "line " + std::to_string(test.line_index) + ": ";
+    const bool intersecting = are_intersecting(gt1, gt2);
+
+    check(are_within_distance(gt1, gt2, 0) == intersecting,
+          line + "are_within_distance(0) answers like are_intersecting");
+    const ClosestPoints points = closest_points(gt1, gt2);
+    check(!intersecting || are_nearly_equal(points.first, points.second),
+          line + "the closest points of the intersecting triangles are nearly equal");
+    check(intersecting || points.distance > 0, line + "the closest points of the other triangles are apart");
+
+    const MeshIndex mesh1({gt1});
+    const MeshIndex mesh2({gt2});
+    check(find_pair_within_distance(mesh1, mesh2, 0).has_value() == intersecting,
+          line + "find_pair_within_distance(0) answers like are_intersecting");
+    const std::optional<MeshClosestPoints> mesh_points = closest_points(mesh1, mesh2);
+    check(mesh_points && mesh_points->points.distance == points.distance,
+          line + "the closest points of the indexes are those of the triangles");
+}
+
+}
+
+int main(const int argc, const char* const* const argv) {
+    if (argc != 2) {
+        std::cerr << "Usage: intersection_of_two_triangles_distance_check <test file>\n";
+        return 1;
+    }
+
+    size_t number_of_pairs = 0;
+    try {
+        std::ifstream input(argv[1]);
+        if (!input) {
+            throw Exception(std::string("Can't open ") + argv[1]);
+        }
+        TestFileReader reader(input);
+        while (const std::optional<TestCase> test = reader.next()) {
+            check_pair(*test);
+            ++number_of_pairs;
+        }
+    } catch (const Exception& e) {
+        std::cerr << e.what() << '\n';
+        return 1;
+    }
+
+    if (number_of_failures != 0 || number_of_pairs == 0) {
+        return 1;
+    }
+    std::cout << "All distance checks passed on " << number_of_pairs << " pairs\n";
+}
@@ -0,0 +1,91 @@
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "intersection_of_two_triangles/algorithms/are_intersecting.hpp"
+#include "intersection_of_two_triangles/algorithms/exact_predicates.hpp"
+#include "intersection_of_two_triangles/exception.hpp"
+#include "intersection_of_two_triangles/io/test_file_reader.hpp"
+#include "intersection_of_two_triangles/primitives/quantized_triangle.hpp"
+
+// Checks that the exact predicates answer like `are_intersecting` and like the expected answers on the pairs of a test
+// file whose vertices are on the lattices of several resolutions, where quantizing loses nothing.
+// Usage: intersection_of_two_triangles_exact_check <test file>
+
+namespace {
+
+using namespace intersection_of_two_triangles;
+
+size_t number_of_failures = 0;
+
+void check(const bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "failed: " << what << '\n';
+        ++number_of_failures;
+    }
+}
+
+[[nodiscard]] bool is_on_lattice(const Quantizer& quantizer, const TestCase& test) {
+    return std::all_of(test.triangles.begin(), test.triangles.end(), [&](const GeneralTriangle& gt) {
+        return std::all_of(gt.vertices.begin(), gt.vertices.end(), [&](const Point& vertex) {
+            return quantizer.is_on_lattice(vertex);
+        });
+    });
+}
+
+// Returns the number of the pairs on the lattice.
+size_t check_resolution(const std::vector<TestCase>& tests, const double resolution) {
+    const Quantizer quantizer(resolution);
+    size_t result = 0;
+    for (const TestCase& test: tests) {
+        if (!is_on_lattice(quantizer, test)) {
+            continue;
+        }
+        ++result;
+        const auto& [gt1, gt2] = test.triangles;
+        const bool exact = are_intersecting(quantizer.quantize(gt1), quantizer.quantize(gt2));
+        const std::string line = "resolution " + std::to_string(resolution) + ", line " +
+                                 std::to_string(test.line_index) + ": ";
+        check(exact == are_intersecting(gt1, gt2), line + "the exact predicates answer like are_intersecting");
+        check(exact == test.expected_answer, line + "the exact predicates give the expected answer");
+    }
+    return result;
+}
+
+}
+
+int main(const int argc, const char* const* const argv) {
+    if (argc != 2) {
+        std::cerr << "Usage: intersection_of_two_triangles_exact_check <test file>\n";
+        return 1;
+    }
+
+    try {
+        std::ifstream input(argv[1]);
+        if (!input) {
+            throw Exception(std::string("Can't open ") + argv[1]);
+        }
+        TestFileReader reader(input);
+        std::vector<TestCase> tests;
+        while (const std::optional<TestCase> test = reader.next()) {
+            tests.push_back(*test);
+        }
+
+        for (const double resolution: {1.0, 0.5, 1.0 / 1024, 1.0 / (1 << 20)}) {
+            const size_t number_of_pairs = check_resolution(tests, resolution);
+            check(number_of_pairs != 0, "resolution " + std::to_string(resolution) + ": some pairs are on the lattice");
+            std::cout << "Resolution " << resolution << ": " << number_of_pairs << " pairs on the lattice\n";
+        }
+    } catch (const Exception& e) {
+        std::cerr << e.what() << '\n';
+        return 1;
+    }
+
+    if (number_of_failures != 0) {
+        return 1;
+    }
+    std::cout << "All exact checks passed\n";
+}
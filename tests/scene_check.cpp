@@ -0,0 +1,149 @@
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "intersection_of_two_triangles/algorithms/mesh_index.hpp"
+#include "intersection_of_two_triangles/algorithms/scene.hpp"
+#include "intersection_of_two_triangles/exception.hpp"
+#include "intersection_of_two_triangles/io/mesh_reader.hpp"
+#include "intersection_of_two_triangles/primitives/rigid_transform.hpp"
+
+// Places copies of two meshes by rigid transforms and checks the answers of `Scene` against the indexes of the
+// triangles transformed into world space, before and after moving a copy.
+// Usage: intersection_of_two_triangles_scene_check <mesh file> <mesh file>
+
+namespace {
+
+using namespace intersection_of_two_triangles;
+
+size_t number_of_failures = 0;
+
+void check(const bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "failed: " << what << '\n';
+        ++number_of_failures;
+    }
+}
+
+// The segment hits as (query, instance, triangle).
+using Hits = std::vector<std::tuple<size_t, size_t, size_t>>;
+// The contacts as (first instance, second instance, first triangle, second triangle).
+using Contacts = std::vector<std::tuple<size_t, size_t, size_t, size_t>>;
+
+struct Placement {
+    std::vector<std::vector<GeneralTriangle>> meshes;
+    std::vector<size_t> instance_meshes;
+    std::vector<RigidTransform> transforms;
+
+    [[nodiscard]] std::vector<GeneralTriangle> world_triangles(const size_t instance) const {
+        std::vector<GeneralTriangle> result;
+        for (const GeneralTriangle& gt: meshes[instance_meshes[instance]]) {
+            result.push_back(transforms[instance](gt));
+        }
+        return result;
+    }
+};
+
+[[nodiscard]] Hits scene_hits(const Scene& scene, const std::vector<Segment>& segments) {
+    Hits result;
+    for (const SceneHit& hit: scene.intersect(segments)) {
+        result.emplace_back(hit.query, hit.instance, hit.triangle);
+    }
+    return result;
+}
+
+[[nodiscard]] Contacts scene_contacts(const Scene& scene) {
+    Contacts result;
+    for (const InstanceContact& contact: scene.find_intersecting_instances()) {
+        for (const auto& [first, second]: contact.triangles) {
+            result.emplace_back(contact.first_instance, contact.second_instance, first, second);
+        }
+    }
+    return result;
+}
+
+// The same answers from one index per instance over its world-space triangles.
+[[nodiscard]] std::pair<Hits, Contacts> world_answers(const Placement& placement,
+                                                      const std::vector<Segment>& segments) {
+    std::vector<MeshIndex> indexes;
+    for (size_t i = 0; i < placement.transforms.size(); ++i) {
+        indexes.emplace_back(placement.world_triangles(i));
+    }
+    Hits hits;
+    for (size_t i = 0; i < indexes.size(); ++i) {
+        for (const MeshHit& hit: indexes[i].intersect(segments)) {
+            hits.emplace_back(hit.query, i, hit.triangle);
+        }
+    }
+    std::sort(hits.begin(), hits.end());
+    Contacts contacts;
+    for (size_t i = 0; i < indexes.size(); ++i) {
+        for (size_t j = i + 1; j < indexes.size(); ++j) {
+            for (const auto& [first, second]: indexes[i].intersect(indexes[j])) {
+                contacts.emplace_back(i, j, first, second);
+            }
+        }
+    }
+    return {hits, contacts};
+}
+
+void compare(const Scene& scene, const Placement& placement, const std::vector<Segment>& segments,
+             const std::string& when) {
+    const auto [hits, contacts] = world_answers(placement, segments);
+    check(!hits.empty() && !contacts.empty(), when + ": the segments hit and the copies touch");
+    check(scene_hits(scene, segments) == hits, when + ": Scene::intersect answers like the world-space indexes");
+    check(scene_contacts(scene) == contacts,
+          when + ": Scene::find_intersecting_instances answers like the world-space indexes");
+}
+
+}
+
+int main(const int argc, const char* const* const argv) {
+    if (argc != 3) {
+        std::cerr << "Usage: intersection_of_two_triangles_scene_check <mesh file> <mesh file>\n";
+        return 1;
+    }
+
+    try {
+        Placement placement;
+        Scene scene;
+        for (const char* const path: {argv[1], argv[2]}) {
+            placement.meshes.push_back(read_mesh(path).triangles());
+            scene.add_mesh(std::make_shared<const MeshIndex>(placement.meshes.back()));
+        }
+        placement.instance_meshes = {0, 1, 0, 1};
+        placement.transforms = {RigidTransform(),
+                                RigidTransform::rotation({1, 1, 0}, 0.3, {0.1, 0.2, 0.05}),
+                                RigidTransform::rotation({0, 0, 1}, 1.1, {1.2, 0.3, 0.1}),
+                                RigidTransform::rotation({1, 2, 3}, 2.0, {10, 10, 10})};
+        for (size_t i = 0; i < placement.transforms.size(); ++i) {
+            scene.add_instance(placement.instance_meshes[i], placement.transforms[i]);
+        }
+
+        // Vertical and slanted segments through the region of the copies.
+        std::vector<Segment> segments;
+        for (double x = -0.45; x < 2.5; x += 0.37) {
+            for (double y = -0.45; y < 2.5; y += 0.37) {
+                segments.emplace_back(Point(x, y, -3), Point(x, y, 3));
+                segments.emplace_back(Point(x, y, -3), Point(x + 1, y + 2, 3));
+            }
+        }
+
+        compare(scene, placement, segments, "placed");
+        placement.transforms[3] = RigidTransform::rotation({1, 2, 3}, 2.0, {0.3, 0.4, 0.2});
+        scene.set_transform(3, placement.transforms[3]);
+        compare(scene, placement, segments, "moved");
+    } catch (const Exception& e) {
+        std::cerr << e.what() << '\n';
+        return 1;
+    }
+
+    if (number_of_failures != 0) {
+        return 1;
+    }
+    std::cout << "All scene checks passed\n";
+}
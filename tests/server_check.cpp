@@ -0,0 +1,154 @@
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "intersection_of_two_triangles/algorithms/are_intersecting.hpp"
+#include "intersection_of_two_triangles/algorithms/mesh_index.hpp"
+#include "intersection_of_two_triangles/exception.hpp"
+#include "intersection_of_two_triangles/io/client.hpp"
+#include "intersection_of_two_triangles/io/mesh_reader.hpp"
+#include "intersection_of_two_triangles/io/protocol.hpp"
+#include "intersection_of_two_triangles/io/server.hpp"
+
+// Runs a `Server` on a thread and checks its answers through `Client` against the library, and that broken or
+// oversized frames end only their own connection.
+// Usage: intersection_of_two_triangles_server_check <socket path> <mesh file>
+
+namespace {
+
+using namespace intersection_of_two_triangles;
+
+size_t number_of_failures = 0;
+
+void check(const bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "failed: " << what << '\n';
+        ++number_of_failures;
+    }
+}
+
+[[nodiscard]] bool are_equal(const std::vector<MeshHit>& hits1, const std::vector<MeshHit>& hits2) {
+    if (hits1.size() != hits2.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < hits1.size(); ++i) {
+        if (hits1[i].query != hits2[i].query || hits1[i].triangle != hits2[i].triangle ||
+            hits1[i].parameter != hits2[i].parameter) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Connects a raw socket, sends the header and `payload_size` bytes of the payload, and returns whether the server
+// closed the connection without answering.
+[[nodiscard]] bool is_dropped(const std::string& socket_path, const FrameHeader& header, const size_t payload_size) {
+    const int descriptor = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    socket_path.copy(address.sun_path, sizeof(address.sun_path) - 1);
+    if (descriptor < 0 || connect(descriptor, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+        return false;
+    }
+    bool result = send(descriptor, &header, sizeof(header), MSG_NOSIGNAL) == sizeof(header);
+    if (payload_size != 0) {
+        // The server may have closed the connection already, so the result isn't checked.
+        const std::string payload(payload_size, '\0');
+        [[maybe_unused]] const ssize_t written = send(descriptor, payload.data(), payload.size(), MSG_NOSIGNAL);
+    }
+    // Nothing more is sent, so the server sees the connection end inside the frame if it waits for the payload.
+    shutdown(descriptor, SHUT_WR);
+    char byte;
+    result = result && read(descriptor, &byte, 1) == 0;
+    close(descriptor);
+    return result;
+}
+
+void run_checks(const std::string& socket_path, const std::string& mesh_path) {
+    const std::vector<GeneralTriangle> triangles = read_mesh(mesh_path).triangles();
+    const MeshIndex index(triangles);
+    const std::vector<Segment> segments{{{0.1, 0.1, -1}, {0.1, 0.1, 2}},
+                                        {{0.3, 0.3, 0.3}, {2, 2, 2}},
+                                        {{5, 5, 5}, {6, 6, 6}}};
+    {
+        Client client(socket_path);
+        const MeshId uploaded = client.upload_mesh(triangles);
+        const MeshId loaded = client.load_mesh_file(mesh_path);
+        check(uploaded != loaded, "the meshes get distinct ids");
+
+        std::vector<TrianglePair> pairs;
+        for (size_t i = 0; i < triangles.size(); ++i) {
+            for (size_t j = 0; j < triangles.size(); ++j) {
+                pairs.push_back({triangles[i], triangles[j]});
+            }
+        }
+        const std::vector<bool> answers = client.are_intersecting(pairs);
+        bool are_answers_equal = answers.size() == pairs.size();
+        for (size_t i = 0; are_answers_equal && i < pairs.size(); ++i) {
+            are_answers_equal = answers[i] == are_intersecting(pairs[i][0], pairs[i][1]);
+        }
+        check(are_answers_equal, "check_pairs answers like are_intersecting");
+
+        check(are_equal(client.intersect(uploaded, segments), index.intersect(segments)),
+              "intersect_segments answers like MeshIndex::intersect");
+        check(client.intersect(uploaded, loaded) == index.intersect(index),
+              "intersect_meshes answers like MeshIndex::intersect");
+
+        client.drop_mesh(uploaded);
+        bool is_rejected = false;
+        try {
+            [[maybe_unused]] const auto hits = client.intersect(uploaded, segments);
+        } catch (const Exception&) {
+            is_rejected = true;
+        }
+        check(is_rejected, "a dropped mesh is rejected");
+        check(!client.intersect(loaded, segments).empty(), "the connection stays open after an error");
+    }
+
+    check(is_dropped(socket_path, {static_cast<std::uint64_t>(Request::check_pairs), std::uint64_t{1} << 40}, 0),
+          "an oversized frame ends the connection");
+    check(is_dropped(socket_path, {static_cast<std::uint64_t>(Request::upload_mesh), max_frame_size}, 1000),
+          "a frame cut short ends the connection");
+    {
+        Client client(socket_path);
+        check(client.are_intersecting({{triangles[0], triangles[0]}}) == std::vector<bool>{true},
+              "the server serves new connections after broken ones");
+    }
+}
+
+}
+
+int main(const int argc, const char* const* const argv) {
+    if (argc != 3) {
+        std::cerr << "Usage: intersection_of_two_triangles_server_check <socket path> <mesh file>\n";
+        return 1;
+    }
+    const std::string socket_path = argv[1];
+
+    try {
+        Server server(socket_path);
+        std::thread server_thread([&server] { server.run(); });
+        try {
+            run_checks(socket_path, argv[2]);
+        } catch (const Exception& e) {
+            std::cerr << e.what() << '\n';
+            ++number_of_failures;
+        }
+        server.stop();
+        server_thread.join();
+    } catch (const Exception& e) {
+        std::cerr << e.what() << '\n';
+        return 1;
+    }
+
+    if (number_of_failures != 0) {
+        return 1;
+    }
+    std::cout << "All server checks passed\n";
+}
@@ -0,0 +1,126 @@
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "intersection_of_two_triangles/algorithms/are_intersecting.hpp"
+#include "intersection_of_two_triangles/algorithms/voxelizer.hpp"
+#include "intersection_of_two_triangles/exception.hpp"
+#include "intersection_of_two_triangles/io/test_file_reader.hpp"
+#include "intersection_of_two_triangles/primitives/box.hpp"
+
+// Checks the triangle-box test on the pairs of a test file against the boxes split into the triangles of their faces:
+// each triangle must touch the bounding box of the other one if the split box touches it, and may touch it otherwise
+// only if it touches the other triangle or the split conservative bounding box. The split boxes miss the triangles
+// through the diagonals of their faces up to the rounding, which the other triangle covers for the pairs of tests.txt
+// touching there. Then checks that `voxelize_dense` and `voxelize_sparse` mark the cells of grids around the pairs
+// which the triangle-box test finds touched.
+// Usage: intersection_of_two_triangles_voxel_check <test file>
+
+namespace {
+
+using namespace intersection_of_two_triangles;
+
+size_t number_of_failures = 0;
+
+void check(const bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "failed: " << what << '\n';
+        ++number_of_failures;
+    }
+}
+
+// The triangle against the 12 triangles of the faces of the box, plus the containment of a vertex.
+[[nodiscard]] bool are_intersecting_split_box(const GeneralTriangle& gt, const Box& box) {
+    std::array<Point, 8> corners;
+    for (size_t i = 0; i < 8; ++i) {
+        corners[i] = Point(i & 1 ? box.max.x() : box.min.x(), i & 2 ? box.max.y() : box.min.y(),
+                           i & 4 ? box.max.z() : box.min.z());
+    }
+    constexpr size_t faces[6][4] = {{0, 1, 3, 2}, {4, 5, 7, 6}, {0, 1, 5, 4}, {2, 3, 7, 6}, {0, 2, 6, 4}, {1, 3, 7, 5}};
+    for (const auto& face: faces) {
+        if (are_intersecting(gt, GeneralTriangle{corners[face[0]], corners[face[1]], corners[face[2]]}) ||
+            are_intersecting(gt, GeneralTriangle{corners[face[0]], corners[face[2]], corners[face[3]]})) {
+            return true;
+        }
+    }
+    return box.contains(gt.vertices[0]);
+}
+
+void check_boxes(const TestCase& test, const std::string& line) {
+    for (const size_t i: {0, 1}) {
+        const GeneralTriangle& gt = test.triangles[i];
+        const GeneralTriangle& other = test.triangles[1 - i];
+        const bool touching = are_intersecting(gt, bounding_box(other));
+        check(touching || !are_intersecting_split_box(gt, bounding_box(other)),
+              line + "the triangle touches the box which the split box touches");
+        check(!touching || are_intersecting(gt, other) ||
+                  are_intersecting_split_box(gt, conservative_bounding_box(other)),
+              line + "the triangle touching the box touches the other triangle or the split conservative box");
+    }
+}
+
+void check_voxels(const TestCase& test, const std::string& line) {
+    const std::vector<GeneralTriangle> triangles(test.triangles.begin(), test.triangles.end());
+    Box bounds;
+    for (const GeneralTriangle& gt: triangles) {
+        bounds.expand(bounding_box(gt));
+    }
+    const double extent = std::max({bounds.extent(0), bounds.extent(1), bounds.extent(2)});
+    if (!(extent > 0)) {
+        return;
+    }
+    for (const double cells_along: {3.0, 7.0}) {
+        const VoxelGrid grid = VoxelGrid::around(triangles, extent / cells_along);
+        std::vector<std::uint8_t> expected(grid.number_of_cells(), 0);
+        std::vector<size_t> expected_indices;
+        for (size_t index = 0; index < grid.number_of_cells(); ++index) {
+            const Box cell = grid.cell_box(grid.cell(index));
+            if (are_intersecting(triangles[0], cell) || are_intersecting(triangles[1], cell)) {
+                expected[index] = 1;
+                expected_indices.push_back(index);
+            }
+        }
+        const std::string grid_name = line + std::to_string(grid.number_of_cells()) + " cells: ";
+        check(voxelize_dense(triangles, grid) == expected,
+              grid_name + "voxelize_dense marks the cells which the triangles touch");
+        check(voxelize_sparse(triangles, grid) == expected_indices,
+              grid_name + "voxelize_sparse lists the cells which the triangles touch");
+    }
+}
+
+}
+
+int main(const int argc, const char* const* const argv) {
+    if (argc != 2) {
+        std::cerr << "Usage: intersection_of_two_triangles_voxel_check <test file>\n";
+        return 1;
+    }
+
+    size_t number_of_pairs = 0;
+    try {
+        std::ifstream input(argv[1]);
+        if (!input) {
+            throw Exception(std::string("Can't open ") + argv[1]);
+        }
+        TestFileReader reader(input);
+        while (const std::optional<TestCase> test = reader.next()) {
+            const std::string line = "line " + std::to_string(test->line_index) + ": ";
+            check_boxes(*test, line);
+            check_voxels(*test, line);
+            ++number_of_pairs;
+        }
+    } catch (const Exception& e) {
+        std::cerr << e.what() << '\n';
+        return 1;
+    }
+
+    if (number_of_failures != 0 || number_of_pairs == 0) {
+        return 1;
+    }
+    std::cout << "All voxel checks passed on " << number_of_pairs << " pairs\n";
+}